@@ -0,0 +1,83 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "./BatchSolver.h"
+#include "./EquationUniverse.h"
+#include "./FeedbackPattern.h"
+
+// plays games against every answer at the same time with the batch solver
+// and returns the amount of games finished per second
+double gamesPerSecond(const NerdleSolver& solver, const unsigned int threads,
+        const vector<string>& answers) {
+    BatchSolver batch(&solver, threads);
+    vector<NerdleGameState> states(answers.size());
+    vector<GameContext> games(answers.size(), batch.newGame());
+    vector<string> guesses(answers.size());
+    // indices of the games that arent won yet
+    vector<size_t> open(answers.size());
+    for (size_t g = 0; g < open.size(); ++g)
+        open[g] = g;
+    auto start = std::chrono::steady_clock::now();
+    for (int turn = 0; turn < 20 && !open.empty(); ++turn) {
+        batch.nextGuesses(states.data(), games.data(), open.size(),
+            guesses.data());
+        size_t kept = 0;
+        for (size_t o = 0; o < open.size(); ++o) {
+            const size_t g = open[o];
+            int pattern = feedbackPattern(guesses[o], answers[g]);
+            if (isWinPattern(pattern, solver.length()))
+                continue;
+            states[o].push_back(patternRow(guesses[o], pattern));
+            // keep the open games at the front of the arrays
+            if (kept != o) {
+                states[kept] = move(states[o]);
+                games[kept] = games[o];
+            }
+            open[kept++] = g;
+        }
+        open.resize(kept);
+    }
+    std::chrono::duration<double> time =
+        std::chrono::steady_clock::now() - start;
+    return answers.size() / time.count();
+}
+
+int main(int argc, char** argv) {
+    const auto usage = []() {
+        std::cerr << "Usage ./BatchBenchmarkMain <lengthOfExpressions> "
+            << "[random|universe|search|entropy|minimax|montecarlo] "
+            << "[games]" << std::endl;
+        std::exit(1);
+    };
+    if (argc < 2 || argc > 4)
+        usage();
+    const int length = std::atoi(argv[1]);
+    if (!isSupportedLength(length)) {
+        std::cerr << "Unsupported length " << argv[1] << std::endl;
+        std::exit(1);
+    }
+    GuessStrategy strategy = GuessStrategy::Universe;
+    if (argc >= 3 && !parseStrategy(argv[2], &strategy))
+        usage();
+    const size_t games = argc == 4 ? std::atoi(argv[3]) : 1000;
+    NerdleSolver solver(length, strategy);
+    const vector<string> answers = spreadSample(
+        EquationUniverse::get(length)->equations(), games);
+
+    const unsigned int cores =
+        std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int threads = 1; ; threads *= 2) {
+        threads = std::min(threads, cores);
+        std::cout << threads << " threads: "
+            << gamesPerSecond(solver, threads, answers) << " games/s"
+            << std::endl;
+        if (threads == cores)
+            break;
+    }
+}
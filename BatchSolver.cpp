@@ -0,0 +1,30 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <string>
+#include "./BatchSolver.h"
+
+BatchSolver::BatchSolver(const NerdleSolver* solver, unsigned int threads)
+        : solver_(solver), pool_(threads) {
+    for (unsigned int i = 0; i < pool_.threads(); ++i)
+        workers_.push_back(make_unique<Worker>(solver_->length()));
+}
+
+void BatchSolver::nextGuesses(const NerdleGameState* states,
+        GameContext* games, const size_t count, string* guesses) {
+    pool_.run(count, [&](size_t i, unsigned int worker) {
+        guesses[i] = solver_->nextGuess(states[i], &games[i],
+            &workers_[worker]->scorer_);
+    });
+}
+
+void BatchSolver::nextGuesses(const NerdleGameState* states,
+        const size_t count, string* guesses) {
+    pool_.run(count, [&](size_t i, unsigned int worker) {
+        // replaying the rows filters the candidates, which can take longer
+        // than the guess itself
+        GameContext game = solver_->gameAt(states[i]);
+        guesses[i] = solver_->nextGuess(states[i], &game,
+            &workers_[worker]->scorer_);
+    });
+}
@@ -0,0 +1,49 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef BATCHSOLVER_H_
+#define BATCHSOLVER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "./NerdleSolver.h"
+#include "./GuessScorer.h"
+#include "./WorkStealingPool.h"
+
+using namespace std;  // NOLINT
+
+// computes the next guesses of many independent games at once
+// the games are spread over a fixed pool of threads, every thread has its
+// own scratch memory and every game its own GameContext
+class BatchSolver {
+ public:
+    // solver decides the guesses of every game and has to outlive the batch
+    // solver, threads as in WorkStealingPool
+    explicit BatchSolver(const NerdleSolver* solver, unsigned int threads = 0);
+    // returns the context of a game that has just started
+    GameContext newGame() const { return solver_->newGame(); }
+    // writes the next guess of game i (with state states[i] and context
+    // games[i]) to guesses[i] for every i from 0 to count - 1
+    void nextGuesses(const NerdleGameState* states, GameContext* games,
+        const size_t count, string* guesses);
+    // same for games without a context, the context of game i is built from
+    // states[i] (see NerdleSolver::gameAt) by the thread that answers it
+    void nextGuesses(const NerdleGameState* states, const size_t count,
+        string* guesses);
+    unsigned int threads() const { return pool_.threads(); }
+
+ private:
+    // scratch memory of one thread
+    struct Worker {
+        explicit Worker(const int length) : pool_(1), scorer_(length, &pool_) {}
+        // scoring inside of one game runs on the thread itself
+        WorkStealingPool pool_;
+        GuessScorer scorer_;
+    };
+    const NerdleSolver* solver_;
+    WorkStealingPool pool_;
+    vector<unique_ptr<Worker>> workers_;
+};
+
+#endif  // BATCHSOLVER_H_
@@ -0,0 +1,55 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "./BatchSolver.h"
+#include "./EquationUniverse.h"
+#include "./FeedbackPattern.h"
+
+// every game of a batch gets the same guesses as if it was played alone
+TEST(BatchSolver, nextGuesses) {
+    for (GuessStrategy strategy : {GuessStrategy::Universe,
+            GuessStrategy::Search, GuessStrategy::Entropy,
+            GuessStrategy::Minimax, GuessStrategy::MonteCarlo}) {
+        NerdleSolver solver(8, strategy);
+        solver.seed(5);
+        BatchSolver batch(&solver, 3);
+        ASSERT_EQ(batch.threads(), 3u);
+        const vector<string>& all = EquationUniverse::get(8)->equations();
+        vector<string> answers;
+        for (size_t a = 0; a < all.size(); a += 1999)
+            answers.push_back(all[a]);
+        vector<NerdleGameState> states(answers.size());
+        vector<GameContext> games(answers.size(), batch.newGame());
+        vector<string> guesses(answers.size());
+        vector<bool> won(answers.size(), false);
+        for (int turn = 0; turn < 8; ++turn) {
+            batch.nextGuesses(states.data(), games.data(), states.size(),
+                guesses.data());
+            // the same without keeping the contexts
+            vector<string> fresh(answers.size());
+            batch.nextGuesses(states.data(), states.size(), fresh.data());
+            ASSERT_EQ(fresh, guesses);
+            for (size_t g = 0; g < answers.size(); ++g) {
+                if (won[g])
+                    continue;
+                // the same game alone
+                NerdleSolver single(8, strategy);
+                single.seed(5);
+                NerdleGameState state;
+                for (const NerdleStatusRow& row : states[g]) {
+                    single.nextGuess(state);
+                    state.push_back(row);
+                }
+                ASSERT_EQ(guesses[g], single.nextGuess(state));
+                int pattern = feedbackPattern(guesses[g], answers[g]);
+                won[g] = isWinPattern(pattern, 8);
+                states[g].push_back(patternRow(guesses[g], pattern));
+            }
+        }
+        for (size_t g = 0; g < answers.size(); ++g)
+            ASSERT_EQ(won[g], true) << answers[g];
+    }
+}
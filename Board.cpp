@@ -1,109 +1,58 @@
 // Copyright 2022, Henry Herröder
 // Author: Henry Herröder
 
+#include <algorithm>
+#include <chrono>
 #include <vector>
-#include <memory>
+#include <string>
 #include "./Board.h"
-
-Board::Board(int length) : defMaxTries(length * 5){
-    length_ = length;
-    usageCaps_ = make_shared<vector<UsageCap>>();
-    for (char c : defNums) {
-        UsageCap uc;
-        uc.character_ = c;
-        uc.allowed_ = length_;
-        uc.used_ = 0;
-        usageCaps_->push_back(uc);
-    }
-    for (char c : defOps) {
-        UsageCap uc;
-        uc.character_ = c;
-        uc.allowed_ = length_;
-        uc.used_ = 0;
-        usageCaps_->push_back(uc);
-    }
-    UsageCap uc;
-    uc.character_ = '=';
-    uc.allowed_ = 1;
-    uc.used_ = 0;
-    usageCaps_->push_back(uc);
-
-    allowedAtPos_ = make_shared<vector<shared_ptr<vector<char>>>>();
-    for (int i = 0; i < length_; ++i) {
-        shared_ptr<vector<char>> base = make_shared<vector<char>>(defNums);
-        allowedAtPos_->push_back(base);
-        // first and last 2 posses cant have defOps
-        if (i >= 1 && i < length_ - 2) {
-            allowedAtPos_->at(i)->insert(
-                allowedAtPos_->at(i)->end(), defOps.begin(), defOps.end());
-        }
-        // first half and last pos cant have =
-        if (i >= length_ / 2 && i < length_ - 1) {
-            allowedAtPos_->at(i)->push_back('=');
-        }
-    }
-}
-
-Board &Board::operator=(const Board &b) {
-    length_ = b.length_;
-    allowedAtPos_ = b.allowedAtPos_;
-    usageCaps_ = b.usageCaps_;
-    return *this;
+#include "./EquationValidator.h"
+#include "./FeedbackPattern.h"
+#include "./NerdleGrammar.h"
+
+Board::Board(int length) {
+    state_.length_ = length;
+    state_.defMaxTries = length * 5;
+    state_.lastWrongPosSize_ = 0;
+    state_.minCount_.fill(0);
+    state_.maxCount_.fill(length);
+    state_.used_.fill(0);
+    state_.minCount_[symbolIndex('=')] = 1;
+    state_.maxCount_[symbolIndex('=')] = 1;
+    state_.allowedAtPos_ = kInitialAllowed[length];
+    state_.random_ = RandomStream(time(NULL));
 }
 
 void Board::update(const NerdleStatusRow& row) {
-    shared_ptr<vector<SymbolPos>> correct = make_shared<vector<SymbolPos>>();
-    //shared_ptr<vector<SymbolPos>> wrongPos = make_shared<vector<SymbolPos>>();
-    lastWrongPos_->clear();
-    shared_ptr<vector<char>> wrong = make_shared<vector<char>>();
-    collectResults(row, correct, lastWrongPos_, wrong);
-    shared_ptr<vector<SymbolPos>> caps = make_shared<vector<SymbolPos>>();
-    hasUsageCaps(correct, lastWrongPos_, wrong, caps);
-    updateUsageCaps(caps);
-    filterWrong(wrong, caps);
-    lockCorrect(correct);
-    deleteWrongPos(lastWrongPos_);
-    deleteWrong(wrong);
-    optimizeAllowedAtPos(correct, caps);
+#ifdef NERDLE_COUNTERS
+    auto start = chrono::steady_clock::now();
+#endif
+    updateHints(row);
+    filterCandidates(row);
+    NERDLE_COUNT(counters_.updates_, 1);
+    NERDLE_COUNT(counters_.updateNanos_, chrono::duration_cast<
+        chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
 }
 
-/*const string Board::getEq() {
-    resetUsage();
-    string eq;
-    bool opFlag = false;
-    for (shared_ptr<vector<char>> cv : *allowedAtPos_) {
-        char c;
-        if (cv->size() > 1) {
-            do {
-                c = cv->at(rand_r(&randSeed) % cv->size());
-                // printf("C: %c\n", c);
-            } while (!isUsable(c));
-            if (!(c >= '0' && c <= '9')) {
-                if (opFlag) {
-                    do {
-                        c = cv->at(rand_r(&randSeed) % cv->size());
-                    } while (!(c >= '0' && c <= '9') && isUsable(c));
-                    opFlag = false;
-                } else {
-                    opFlag = true;
-                }
-            }
-        } else {
-            c = cv->at(0);
-        }
-        addUsage(c);
-        eq.push_back(c);
-    }
-    return eq;
-}*/
+void Board::updateHints(const NerdleStatusRow& row) {
+    RowCounts counts;
+    collectResults(row, &counts);
+    updateUsageCaps(counts);
+    lockCorrect(row);
+    deleteWrongPos(row);
+    deleteWrong();
+    optimizeAllowedAtPos(row);
+}
 
 string Board::getEqCO() {
     resetUsage();
     string eq;
-    for (shared_ptr<vector<char>> cv : * allowedAtPos_) {
-        if (cv->size() == 1) {
-            eq.push_back(cv->at(0));
-            addUsage(cv->at(0));
+    for (int i = 0; i < state_.length_; ++i) {
+        SymbolMask m = state_.allowedAtPos_[i];
+        if (m != 0 && (m & (m - 1)) == 0) {
+            char c = symbolChar(__builtin_ctz(m));
+            eq.push_back(c);
+            addUsage(c);
         } else {
             eq.push_back('_');
         }
@@ -112,18 +61,15 @@ string Board::getEqCO() {
 }
 
 string Board::getEqAddWP(string eq) {
-    if (lastWrongPos_->size() > 0) {
+    if (state_.lastWrongPosSize_ > 0) {
         // get all possible postions for wrongpos symbols
         vector<WrongPosUsage> wpusages;
-        for (SymbolPos sp : *lastWrongPos_) {
+        for (size_t w = 0; w < state_.lastWrongPosSize_; ++w) {
             WrongPosUsage wpu;
-            wpu.character_ = sp.character_;
-            for (size_t i = 0; i < allowedAtPos_->size(); ++i) {
-                //allowedAtPos_->at(i)->size() > 1 &&
-
-                if (isInVec(allowedAtPos_->at(i), sp.character_)) {
+            wpu.character_ = state_.lastWrongPos_[w].character_;
+            for (int i = 0; i < state_.length_; ++i) {
+                if (state_.allowedAtPos_[i] & symbolBit(wpu.character_))
                     wpu.posses.push_back(i);
-                }
             }
             wpusages.push_back(wpu);
         }
@@ -135,12 +81,15 @@ string Board::getEqAddWP(string eq) {
                     int pos;
                     int maxTries = i->posses.size() * 5;
                     do {
-                        pos = i->posses.at(rand_r(&randSeed) % i->posses.size());
+                        pos = i->posses.at(
+                            state_.random_.below(i->posses.size()));
                         --maxTries;
                     } while ((eq.at(pos) != '_' ||
                         !validForEq(eq, pos, i->character_)) && maxTries > 0);
-                    if (maxTries == 0)
+                    if (maxTries == 0) {
+                        NERDLE_COUNT(counters_.addWPExhausted_, 1);
                         continue;
+                    }
                     eq.at(pos) = i->character_;
                     addUsage(i->character_);
                     wpusages.erase(i);
@@ -150,83 +99,50 @@ string Board::getEqAddWP(string eq) {
             ++min;
 
             // if no valid position can befound exit
-            if (min > defMaxTries)
+            if (min > state_.defMaxTries)
                 break;
         }
-        // << "B" << endl;
     }
     return eq;
 }
 
-/*string Board::getEqAddWP(string eq, string lastTry) {
-    if (lastWrongPos_->size() > 0) {
-        shared_ptr<vector<SymbolPos>> notUsed =
-            make_shared<vector<SymbolPos>>(*lastWrongPos_);
-        
-        for (SymbolPos sp : *notUsed) {
-            for (shared_ptr<vector<char>> vc : *allowedAtPos_) {
-                if (isInVec(vc, sp.character_)) {
-
-                }
-            }
-        }
-        while (notUsed->size() > 0) {
-            int i = rand_r(&randSeed) % eq.size();
-            if (eq.at(i) == '_') {
-                //printf("a\n");
-                SymbolPos sp;
-                for (auto u = notUsed->begin(); u != notUsed->end(); ++u) {
-                    sp = *u;
-                    if (sp.index_ != static_cast<int>(i) &&
-                            isInVec(allowedAtPos_->at(i), sp.character_)) {
-                        eq.at(i) = sp.character_;
-                        addUsage(sp.character_);
-                        notUsed->erase(u);
-                        break;
-                    }
-                }
-            }
-        }
-    }
-    return eq;
-}*/
-
 string Board::getEqGuessRest(string eq) {
+    // the prefix is read by the grammar, so only symbols that can follow it
+    // are guessed and a broken prefix stops the guess at once
+    GrammarState state = GrammarState::Operand;
     for (size_t i = 0; i < eq.size(); ++i) {
         if (eq.at(i) == '_') {
-            shared_ptr<vector<char>> atp = make_shared<vector<char>>(*allowedAtPos_->at(i));
-
             // filter out all symbols that arent useable any more
-            for (auto u = atp->begin(); u != atp->end(); u++) {
-                if (!isUsable(*u)) {
-                    atp->erase(u);
-                    u--;
-                }
+            SymbolMask atp = state_.allowedAtPos_[i] & grammarMask(state);
+            for (int s = 0; s < kSymbols; ++s) {
+                if (state_.used_[s] >= state_.maxCount_[s])
+                    atp &= ~(1u << s);
             }
-            if (atp->size() == 0)
+            if (atp == 0) {
+                NERDLE_COUNT(counters_.guessRestEmpty_, 1);
                 return "";
+            }
 
             // now guess with allowed symbols
             char c;
             // if a valid char cant be found within maxTries just accept a
             // wrong eq
-            size_t maxTries = defMaxTries;
+            size_t maxTries = state_.defMaxTries;
             do {
-                c = atp->at(rand_r(&randSeed) % atp->size());
+                c = randomSymbol(atp);
                 --maxTries;
             } while (!validForEq(eq, i, c) && maxTries > 0);
             // its important to only addUsage if a valid char was found
             // otherwise the solver will get stuck
-            if (maxTries > 0) {
-                if (!isNum(c) && !isNum(eq.at(i - 1))) {
-                    do {
-                        c = atp->at(rand_r(&randSeed) % atp->size());
-                    } while (!isNum(c) || !validForEq(eq, i, c));
-                }
+            if (maxTries > 0)
                 addUsage(c);
-            }
+            else
+                NERDLE_COUNT(counters_.guessRestExhausted_, 1);
             eq.at(i) = c;
         }
+        state = grammarStep(state, eq.at(i));
+        if (state == GrammarState::Dead)
+            return eq;
     }
     return eq;
 }
@@ -235,27 +151,29 @@ const string Board::getEq() {
     resetUsage();
     string eq;
     bool opFlag = false;
-    for (shared_ptr<vector<char>> cv : *allowedAtPos_) {
+    for (int i = 0; i < state_.length_; ++i) {
+        SymbolMask notUsed = state_.allowedAtPos_[i];
         char c;
-        if (cv->size() > 1) {
-            shared_ptr<vector<char>> notUsed = make_shared<vector<char>>(*cv);
+        if (notUsed & (notUsed - 1)) {
             do {
-                c = notUsed->at(rand_r(&randSeed) % notUsed->size());
-                deleteFromVec(notUsed, c);
-            } while (!isUsable(c));
+                c = randomSymbol(notUsed);
+                notUsed &= ~symbolBit(c);
+            } while (!isUsable(c) && notUsed != 0);
             if (!isNum(c)) {
                 if (opFlag) {
-                    do {
-                        c = notUsed->at(rand_r(&randSeed) % notUsed->size());
-                        deleteFromVec(notUsed, c);
-                    } while (!isNum(c) || !isUsable(c));
+                    while (notUsed != 0) {
+                        c = randomSymbol(notUsed);
+                        notUsed &= ~symbolBit(c);
+                        if (isNum(c) && isUsable(c))
+                            break;
+                    }
                     opFlag = false;
                 } else {
                     opFlag = true;
                 }
             }
         } else {
-            c = cv->at(0);
+            c = notUsed ? symbolChar(__builtin_ctz(notUsed)) : '_';
         }
         addUsage(c);
         eq.push_back(c);
@@ -263,252 +181,419 @@ const string Board::getEq() {
     return eq;
 }
 
-void Board::addUsage(const char c) {
-    ++usageCaps_->at(getUsageCapIndex(c)).used_;
+bool Board::deriveRhs(string* eq) const {
+    const int length = state_.length_;
+    const size_t equals = eq->find('=');
+    if (eq->size() != static_cast<size_t>(length) || equals == string::npos)
+        return false;
+    int64_t value;
+    int ops;
+    if (lhsValue(string_view(*eq).substr(0, equals), &value, &ops) !=
+            EquationError::None || ops == 0)
+        return false;
+    int64_t low, high;
+    rhsValues(length - 1 - equals, &low, &high);
+    if (value < low || value > high)
+        return false;
+    string derived = *eq;
+    for (int i = length - 1; i > static_cast<int>(equals); --i) {
+        derived[i] = '0' + value % 10;
+        value /= 10;
+    }
+    if (!isConsistent(derived))
+        return false;
+    *eq = derived;
+    return true;
 }
 
-bool Board::isUsable(const char c) const {
-    UsageCap uc = usageCaps_->at(getUsageCapIndex(c));
-    return uc.allowed_ > uc.used_;
+string Board::getEqSearch() const {
+    SearchState st;
+    // lhs needs at least "1+1" and rhs at least one digit
+    for (int lhs = 3; lhs <= state_.length_ - 2; ++lhs) {
+        if (!(state_.allowedAtPos_[lhs] & kEqualsMask))
+            continue;
+        st.lhsLength_ = lhs;
+        rhsValues(state_.length_ - 1 - lhs, &st.rhsLow_, &st.rhsHigh_);
+        bool possible = true;
+        for (int i = 0; i < state_.length_; ++i) {
+            SymbolMask part = i < lhs ? kNumMask | kOpMask :
+                i == lhs ? kEqualsMask : kNumMask;
+            st.allowed_[i] = state_.allowedAtPos_[i] & part;
+            possible = possible && st.allowed_[i] != 0;
+        }
+        if (!possible)
+            continue;
+        st.allowedFrom_[state_.length_].fill(0);
+        for (int i = state_.length_ - 1; i >= 0; --i) {
+            for (int s = 0; s < kSymbols; ++s) {
+                st.allowedFrom_[i][s] = st.allowedFrom_[i + 1][s] +
+                    ((st.allowed_[i] >> s) & 1);
+            }
+        }
+        st.used_.fill(0);
+        if (canComplete(st, 0) && searchFrom(&st, 0, SearchValue()))
+            return string(st.eq_, state_.length_);
+    }
+    return "";
+}
+
+bool Board::isConsistent(const string& eq) const {
+    if (eq.size() != static_cast<size_t>(state_.length_))
+        return false;
+    array<int, kSymbols> count = {};
+    for (int i = 0; i < state_.length_; ++i) {
+        int s = symbolIndex(eq[i]);
+        if (s < 0 || !(state_.allowedAtPos_[i] & (1u << s)))
+            return false;
+        ++count[s];
+    }
+    for (int s = 0; s < kSymbols; ++s) {
+        if (count[s] < state_.minCount_[s] || count[s] > state_.maxCount_[s])
+            return false;
+    }
+    return true;
+}
+
+bool Board::isConsistent(const PackedEquation eq) const {
+    array<int, kSymbols> count = {};
+    for (int i = 0; i < state_.length_; ++i) {
+        int s = packedSymbol(eq, i);
+        if (s < 0 || !(state_.allowedAtPos_[i] & (1u << s)))
+            return false;
+        ++count[s];
+    }
+    for (int s = 0; s < kSymbols; ++s) {
+        if (count[s] < state_.minCount_[s] || count[s] > state_.maxCount_[s])
+            return false;
+    }
+    return true;
+}
+
+SolverCounters Board::takeCounters() {
+    SolverCounters taken = counters_;
+    counters_ = SolverCounters();
+    return taken;
 }
 
-int Board::getUsageCapIndex(const char c) const {
-    for (unsigned int i = 0; i < usageCaps_->size(); ++i) {
-        if (usageCaps_->at(i).character_ == c)
-            return i;
+void Board::trackCandidates(shared_ptr<const EquationUniverse> universe) {
+    universe_ = universe;
+    allCandidates_ = true;
+    candidates_.clear();
+    index_ = universe_ == EquationUniverse::get(universe_->length()) ?
+        CandidateIndex::get(universe_->length()) : nullptr;
+}
+
+size_t Board::candidateCount() const {
+    if (!universe_)
+        return 0;
+    return allCandidates_ ? universe_->size() : candidates_.size();
+}
+
+void Board::filterCandidates(const NerdleStatusRow& row) {
+    if (!universe_)
+        return;
+    if (index_ && (allCandidates_ ||
+            candidates_.size() * 64 >= index_->size())) {
+        filterCandidatesByIndex(row);
+        return;
+    }
+    string guess;
+    for (const CharacterAndStatus& cas : row)
+        guess.push_back(cas.character_);
+    const PackedEquation packedGuess = packEquation(guess);
+    const int pattern = rowPattern(row);
+    const vector<PackedEquation>& eqs = universe_->packed();
+    // the cheap check against the updated constraints sorts out most
+    // equations before the exact pattern is computed
+    auto keep = [&](const uint32_t e) {
+        return isConsistent(eqs[e]) &&
+            feedbackPattern(packedGuess, eqs[e]) == pattern;
+    };
+    if (allCandidates_) {
+        allCandidates_ = false;
+        for (size_t e = 0; e < eqs.size(); ++e) {
+            if (keep(e))
+                candidates_.push_back(e);
+        }
+        return;
+    }
+    // compact the survivors in place
+    size_t kept = 0;
+    for (const uint32_t e : candidates_) {
+        if (keep(e))
+            candidates_[kept++] = e;
+    }
+    candidates_.resize(kept);
+}
+
+void Board::filterCandidatesByIndex(const NerdleStatusRow& row) {
+    vector<uint64_t> alive(index_->words(), 0);
+    if (allCandidates_) {
+        fill(alive.begin(), alive.end(), ~0ull);
+        if (index_->size() % 64)
+            alive.back() = (1ull << (index_->size() % 64)) - 1;
+    } else {
+        for (const uint32_t e : candidates_)
+            alive[e / 64] |= 1ull << (e % 64);
     }
-    return -1;
+    index_->filter(row, alive.data());
+    allCandidates_ = false;
+    candidates_.clear();
+    for (size_t w = 0; w < alive.size(); ++w) {
+        for (uint64_t bits = alive[w]; bits; bits &= bits - 1)
+            candidates_.push_back(w * 64 + __builtin_ctzll(bits));
+    }
+}
+
+void Board::addUsage(const char c) {
+    int s = symbolIndex(c);
+    if (s >= 0)
+        ++state_.used_[s];
+}
+
+bool Board::isUsable(const char c) const {
+    int s = symbolIndex(c);
+    return s >= 0 && state_.maxCount_[s] > state_.used_[s];
 }
 
 void Board::collectResults(const NerdleStatusRow& row,
-        shared_ptr<vector<SymbolPos>> correct,
-        shared_ptr<vector<SymbolPos>> wrongPos,
-        shared_ptr<vector<char>> wrong) const {
-    for (unsigned int i = 0; i < row.size(); ++i) {
-        SymbolPos sp;
-        sp.character_ = row.at(i).character_;
-        sp.index_ = i;
-        switch (row.at(i).status_) {
+        RowCounts* counts) const {
+    for (const CharacterAndStatus& cas : row) {
+        int s = symbolIndex(cas.character_);
+        switch (cas.status_) {
             case NerdleStatus::Correct:
-                correct->push_back(sp);
+                ++counts->correct_[s];
                 break;
             case NerdleStatus::WrongPosition:
-                wrongPos->push_back(sp);
+                ++counts->wrongPos_[s];
                 break;
             case NerdleStatus::Wrong:
-                wrong->push_back(sp.character_);
+                ++counts->wrong_[s];
                 break;
         }
     }
 }
 
-void Board::hasUsageCaps(const shared_ptr<vector<SymbolPos>> correct,
-        const shared_ptr<vector<SymbolPos>> wrongPos,
-        const shared_ptr<vector<char>> wrong,
-        shared_ptr<vector<SymbolPos>> caps) const {
-    for (char c : *wrong) {
-        int cap = 0;
-        for (SymbolPos spc : *correct) {
-            if (c == spc.character_) {
-                ++cap;
-            }
-        }
-        for (SymbolPos spwp : *wrongPos) {
-            if (c == spwp.character_) {
-                ++cap;
-            }
-        }
-        if (cap > 0) {
-            SymbolPos sp;
-            sp.character_ = c;
-            sp.index_ = cap;
-            caps->push_back(sp);
-        }
-    }    
+void Board::updateUsageCaps(const RowCounts& counts) {
+    for (int s = 0; s < kSymbols; ++s) {
+        int present = counts.correct_[s] + counts.wrongPos_[s];
+        if (present > state_.minCount_[s])
+            state_.minCount_[s] = present;
+        // a wrong symbol means that there are no more copies than marked
+        if (counts.wrong_[s] > 0 && present < state_.maxCount_[s])
+            state_.maxCount_[s] = present;
+    }
 }
 
-void Board::filterWrong(shared_ptr<vector<char>> wrong,
-        const shared_ptr<vector<SymbolPos>> caps) const {
-    for (SymbolPos sp : *caps) {
-        deleteFromVec(wrong, sp.character_);
+void Board::lockCorrect(const NerdleStatusRow& row) {
+    for (size_t i = 0; i < row.size(); ++i) {
+        if (row[i].status_ == NerdleStatus::Correct)
+            state_.allowedAtPos_[i] = symbolBit(row[i].character_);
     }
 }
 
-void Board::lockCorrect(const shared_ptr<vector<SymbolPos>> correct) {
-    for (SymbolPos sp : *correct) {
-        allowedAtPos_->at(sp.index_)->clear();
-        allowedAtPos_->at(sp.index_)->push_back(sp.character_);
+void Board::deleteWrongPos(const NerdleStatusRow& row) {
+    state_.lastWrongPosSize_ = 0;
+    for (size_t i = 0; i < row.size(); ++i) {
+        if (row[i].status_ == NerdleStatus::Correct)
+            continue;
+        // neither wrongpos nor wrong symbols can be at this position
+        state_.allowedAtPos_[i] &= ~symbolBit(row[i].character_);
+        if (row[i].status_ == NerdleStatus::WrongPosition) {
+            SymbolPos sp;
+            sp.character_ = row[i].character_;
+            sp.index_ = i;
+            state_.lastWrongPos_[state_.lastWrongPosSize_++] = sp;
+        }
     }
 }
 
-void Board::optimizeAllowedAtPos(const shared_ptr<vector<SymbolPos>> correct,
-                                    const shared_ptr<vector<SymbolPos>> caps) {
-    shared_ptr<vector<char>> sDO = make_shared<vector<char>>(defOps);
-    shared_ptr<vector<char>> sDN = make_shared<vector<char>>(defNums);
-    for (size_t i = 0; i < correct->size(); ++i) {
-        SymbolPos sp = correct->at(i);
-        if (!isNum(sp.character_)) {
-            // if op is correct there cant be one next to it
-            if (sp.index_ > 0) {
-                deleteFromVec(allowedAtPos_->at(sp.index_ - 1), sDO);
-            }
-            if (sp.index_ < length_ - 1) {
-                deleteFromVec(allowedAtPos_->at(sp.index_ + 1), sDO);
-            }
-            // if op is followed by a 0 the next symbol has to be a op
-            if (sp.index_ < length_ - 2 && correct->size() < i + 1)
-                if (correct->at(i + 1).character_ == '0') {
-                    deleteFromVec(allowedAtPos_->at(sp.index_ + 2), sDN);
-                }
-            // if there is an = than there cant be an op after it
-            if(!equalsFlag && sp.character_ == '=') {
-                equalsFlag = true;
-                for (size_t u = sp.index_ + 1; u < allowedAtPos_->size(); ++u) {
-                    deleteFromVec(allowedAtPos_->at(u), sDO);
-                    deleteFromVec(allowedAtPos_->at(u), '=');
-                }
-                // an = with 2 or more numbers to the right cant be followed
-                // by a 0
-                if (sp.index_ < length_ - 2) {
-                    deleteFromVec(allowedAtPos_->at(sp.index_ + 1), '0');
-                }
-            }
-            // if the amount of correct symbols is equal to the allowed cap it
-            // can be deleted from all other posses
-            for (SymbolPos s : *caps) {
-                int amount = 0;
-                for (SymbolPos c : *correct) {
-                    if (c.character_ == s.character_)
-                        ++amount;
-                }
-                if (amount == s.index_) {
-                    for (size_t u = 0; u < allowedAtPos_->size(); ++u) {
-                        for (SymbolPos cor : *correct) {
-                            // 80 chars line limit is not enough sry :(
-                            if (cor.index_ != u &&
-                                    cor.character_ == s.character_ &&
-                                    allowedAtPos_->at(u)->at(0) !=
-                                    cor.character_)
-                                deleteFromVec(allowedAtPos_->at(u),
-                                              s.character_);
-                        }
-                    }
-                }
-            }
+void Board::deleteWrong() {
+    SymbolMask absent = 0;
+    for (int s = 0; s < kSymbols; ++s) {
+        if (state_.maxCount_[s] == 0)
+            absent |= 1u << s;
+    }
+    for (int i = 0; i < state_.length_; ++i)
+        state_.allowedAtPos_[i] &= ~absent;
+}
+
+void Board::optimizeAllowedAtPos(const NerdleStatusRow& row) {
+    const SymbolMask nonNum = kOpMask | kEqualsMask;
+    for (int i = 0; i < state_.length_; ++i) {
+        SymbolMask m = state_.allowedAtPos_[i];
+        // only positions that are known to hold an op or = matter here
+        if ((m & kNumMask) || m == 0)
+            continue;
+        // if op is correct there cant be one next to it
+        if (i > 0)
+            state_.allowedAtPos_[i - 1] &= ~nonNum;
+        if (i < state_.length_ - 1)
+            state_.allowedAtPos_[i + 1] &= ~nonNum;
+        // if there is an = than there cant be an op after it
+        if (m == kEqualsMask) {
+            for (int u = i + 1; u < state_.length_; ++u)
+                state_.allowedAtPos_[u] &= ~nonNum;
+            // an = with 2 or more numbers to the right cant be followed
+            // by a 0
+            if (i < state_.length_ - 2)
+                state_.allowedAtPos_[i + 1] &= ~symbolBit('0');
+        }
+    }
+    // if the amount of locked symbols is equal to the allowed cap it
+    // can be deleted from all other posses
+    array<int, kSymbols> locked = {};
+    for (int i = 0; i < state_.length_; ++i) {
+        SymbolMask m = state_.allowedAtPos_[i];
+        if (m != 0 && (m & (m - 1)) == 0)
+            ++locked[__builtin_ctz(m)];
+    }
+    for (int s = 0; s < kSymbols; ++s) {
+        if (locked[s] == 0 || locked[s] < state_.maxCount_[s])
+            continue;
+        for (int i = 0; i < state_.length_; ++i) {
+            if (state_.allowedAtPos_[i] != (1u << s))
+                state_.allowedAtPos_[i] &= ~(1u << s);
         }
     }
     // check if any posses that werent in correct got optimized to size 1
     // and update lastWrongPos accordingly
-    for(size_t i = 0; i < allowedAtPos_->size(); ++i) {
-        if (allowedAtPos_->at(i)->size() == 1) {
-            bool wasCor = false;
-            for (SymbolPos sp: *correct) {
-                if (static_cast<int>(sp.index_) == i) {
-                    wasCor = true;
-                    break;
-                }
-            }
-            if (!wasCor)
-                optimizeLastWrongPos(allowedAtPos_->at(i)->at(0));
-        }
+    for (int i = 0; i < state_.length_; ++i) {
+        SymbolMask m = state_.allowedAtPos_[i];
+        if (m != 0 && (m & (m - 1)) == 0 &&
+                row.at(i).status_ != NerdleStatus::Correct)
+            optimizeLastWrongPos(symbolChar(__builtin_ctz(m)));
     }
 }
 
 void Board::optimizeLastWrongPos(const char c) {
-    for (auto i = lastWrongPos_->begin(); i != lastWrongPos_->end(); ++i) {
-        if (i->character_ == c) {
-            lastWrongPos_->erase(i);
+    for (size_t i = 0; i < state_.lastWrongPosSize_; ++i) {
+        if (state_.lastWrongPos_[i].character_ == c) {
+            state_.lastWrongPos_[i] =
+                state_.lastWrongPos_[--state_.lastWrongPosSize_];
             return;
         }
     }
 }
 
-bool Board::validForEq(const string eq, const size_t pos, const char c) const {
-    if (!isNum(c)) {
-        if ((!isUnderscore(eq.at(pos - 1)) && !isNum(eq.at(pos - 1))) ||
-                (!isUnderscore(eq.at(pos + 1)) && !isNum(eq.at(pos + 1)) &&
-                eq.at(pos + 1) != '0'))
-            return false;
-    }
-    if (pos == 1 && eq.at(0) == '0' && isNum(c))
+bool Board::validForEq(const string& eq, const size_t pos,
+        const char c) const {
+    const bool prevSet = pos > 0 && !isUnderscore(eq[pos - 1]);
+    const bool prevNum = pos > 0 && isNum(eq[pos - 1]);
+    const bool nextSet = pos + 1 < eq.size() && !isUnderscore(eq[pos + 1]);
+    const bool nextNum = pos + 1 < eq.size() && isNum(eq[pos + 1]);
+    // ops need numbers on both sides
+    if (!isNum(c) && ((prevSet && !prevNum) || (nextSet && !nextNum)))
         return false;
-    if (c == '0') {
-        if (pos < eq.size() - 1 && pos > 0 &&
-            !isUnderscore(eq.at(pos - 1)) && !isNum(eq.at(pos - 1)) &&
-            isNum(eq.at(pos + 1)))
-            return false;
-        if (pos == 0 && isNum(eq.at(pos + 1)))
-            return false;
-    }
-    if (pos > 0 && !isUnderscore(eq.at(pos - 1)) &&
-            !isNum(eq.at(pos - 1)) && !isNum(c)) {
+    // no leading zeros
+    if (pos == 1 && eq[0] == '0' && isNum(c))
+        return false;
+    if (c == '0' && nextNum && (pos == 0 || (prevSet && !prevNum)))
         return false;
-    }
     return true;
 }
 
-bool Board::isInVec(const shared_ptr<vector<char>> vec, const char c) const {
-    for (char vc : *vec) {
-        if (vc == c)
+bool Board::searchFrom(SearchState* st, const int pos,
+        const SearchValue& v) const {
+    if (pos == state_.length_)
+        return true;
+    SymbolMask cand = st->allowed_[pos];
+    for (int s = 0; s < kSymbols; ++s) {
+        if (st->used_[s] >= state_.maxCount_[s])
+            cand &= ~(1u << s);
+    }
+    // every rhs digit follows from the value of the lhs
+    if (pos > st->lhsLength_)
+        cand &= 1u << (st->value_ / powerOf10(state_.length_ - 1 - pos) % 10);
+    // an operator or '=' ends the current number, which only has to be
+    // checked once for all of them
+    // the grammar rules out leading zeros and operators without numbers
+    cand &= grammarMask(v.state_);
+    SearchValue closed = v;
+    if ((cand & (kOpMask | kEqualsMask)) &&
+            !closeNumber(*st, pos, &closed))
+        cand &= kNumMask;
+
+    for (; cand != 0; cand &= cand - 1) {
+        const int s = __builtin_ctz(cand);
+        const char c = symbolChar(s);
+        SearchValue next = closed;
+        if (isNum(c)) {
+            next = v;
+            next.num_ = v.num_ * 10 + (c - '0');
+        } else if (c == '=') {
+            if (v.ops_ == 0)
+                continue;
+            st->value_ = closed.sum_ + closed.sign_ * closed.term_;
+        } else if (c == '+' || c == '-') {
+            next.sum_ += next.sign_ * next.term_;
+            next.sign_ = c == '+' ? 1 : -1;
+            next.term_ = 1;
+            next.op_ = 0;
+            ++next.ops_;
+        } else {
+            // 0 cant be an operand of * or /
+            if (next.term_ == 0)
+                continue;
+            next.op_ = c;
+            ++next.ops_;
+        }
+        next.state_ = grammarStep(v.state_, c);
+        st->eq_[pos] = c;
+        ++st->used_[s];
+        if (canComplete(*st, pos + 1) && searchFrom(st, pos + 1, next))
             return true;
+        --st->used_[s];
     }
     return false;
 }
 
-void Board::deleteWrongPos(const shared_ptr<vector<SymbolPos>> wrongPos) {
-    for (SymbolPos sp : *wrongPos) {
-        deleteFromVec(allowedAtPos_->at(sp.index_), sp.character_);
-    }
-}
-
-void Board::deleteWrong(const shared_ptr<vector<char>> wrong) {
-    for (shared_ptr<vector<char>> &cv : *allowedAtPos_) {
-        deleteFromVec(cv, wrong);
+bool Board::closeNumber(const SearchState& st, const int pos,
+        SearchValue* v) const {
+    if (v->op_ == '*') {
+        if (v->num_ == 0)
+            return false;
+        v->term_ *= v->num_;
+    } else if (v->op_ == '/') {
+        if (v->num_ == 0 || v->term_ % v->num_ != 0)
+            return false;
+        v->term_ /= v->num_;
+    } else {
+        v->term_ = v->num_;
     }
+    v->num_ = 0;
+    // a single char is not enough for operator and number
+    const int rest = st.lhsLength_ - pos;
+    if (rest == 1)
+        return false;
+    int64_t low, high;
+    reachableValues(v->sum_, v->sign_, v->term_, rest, &low, &high);
+    return high >= st.rhsLow_ && low <= st.rhsHigh_;
 }
 
-void Board::updateUsageCaps(shared_ptr<vector<SymbolPos>> caps) {
-    for (SymbolPos sp : *caps) {
-        for (UsageCap &uc : *usageCaps_) {
-            if (uc.character_ == sp.character_) {
-                uc.allowed_ = sp.index_;
-                break;
-            }
-        }
+bool Board::canComplete(const SearchState& st, const int pos) const {
+    // wrongpos symbols of earlier rows are part of minCount_ and are already
+    // removed from the positions they were tried at
+    int missing = 0;
+    for (int s = 0; s < kSymbols; ++s) {
+        int m = state_.minCount_[s] - st.used_[s];
+        if (m <= 0)
+            continue;
+        if (m > st.allowedFrom_[pos][s])
+            return false;
+        missing += m;
     }
+    return missing <= state_.length_ - pos;
 }
 
 void Board::resetUsage() {
-    for (UsageCap &uc : *usageCaps_) {
-        uc.used_ = 0;
-    }
-}
-
-bool Board::deleteFromVec(shared_ptr<vector<char>> vec, const char c) const {
-    for (vector<char>::iterator i = vec->begin(); i != vec->end(); ++i) {
-        if (*i == c) {
-            vec->erase(i);
-            return true;
-        }
-    }
-    return false;
-}
-
-bool Board::deleteFromVec(shared_ptr<vector<char>> vec,
-        const shared_ptr<vector<char>> chars) const {
-    bool removedItem = false;
-    for (char c : *chars) {
-        for (vector<char>::iterator i = vec->begin(); i != vec->end(); ++i) {
-            if (*i == c) {
-                vec->erase(i);
-                removedItem = true;
-                break;
-            }
-        }
-    }
-    return removedItem;
+    state_.used_.fill(0);
 }
 
-bool Board::isNum(const char c) const {
-    return (c >= '0' && c <= '9');
+char Board::randomSymbol(const SymbolMask mask) {
+    int k = state_.random_.below(__builtin_popcount(mask));
+    SymbolMask m = mask;
+    for (; k > 0; --k)
+        m &= m - 1;
+    return symbolChar(__builtin_ctz(m));
 }
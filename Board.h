@@ -5,11 +5,20 @@
 #define BOARD_H_
 
 #include <gtest/gtest.h>
-#include <vector>
+#include <array>
 #include <memory>
+#include <vector>
+#include <string>
 #include <random>
+#include <type_traits>
 
+#include "./CandidateIndex.h"
+#include "./EquationUniverse.h"
 #include "./NerdleBenchmark.h"
+#include "./NerdleGrammar.h"
+#include "./NerdleSymbols.h"
+#include "./RandomStream.h"
+#include "./SolverCounters.h"
 
 using namespace std;  // NOLINT
 
@@ -19,33 +28,93 @@ struct SymbolPos {
     int index_;
 };
 
-// saves how often a character is allowed to be used and how often it is
-// currently used
-struct UsageCap {
-    char character_;
-    int allowed_;
-    int used_;
-};
-
 // saves character and where its still allowed for wrong pos symbols
 struct WrongPosUsage {
     char character_;
     vector<size_t> posses;
 };
 
+// amount of correct, wrongpos and wrong hints per symbol of one status row
+struct RowCounts {
+    array<int, kSymbols> correct_ = {};
+    array<int, kSymbols> wrongPos_ = {};
+    array<int, kSymbols> wrong_ = {};
+};
+
+// running value of the lhs while Board::getEqSearch places symbols
+struct SearchValue {
+    // value of all finished terms and sign of the current term
+    int64_t sum_ = 0;
+    int sign_ = 1;
+    // value of the current term and op that combines it with num_
+    int64_t term_ = 1;
+    char op_ = 0;
+    // number that is currently written
+    int64_t num_ = 0;
+    // amount of operators placed so far
+    int ops_ = 0;
+    // where the symbols so far left the grammar automaton
+    GrammarState state_ = GrammarState::Operand;
+};
+
+// everything Board::getEqSearch needs for one fixed position of '='
+struct SearchState {
+    int lhsLength_;
+    // values the rhs can show and the value the lhs ended up with
+    int64_t rhsLow_;
+    int64_t rhsHigh_;
+    int64_t value_;
+    // allowed symbols per position with '=' fixed at lhsLength_
+    array<SymbolMask, kMaxLength> allowed_;
+    // how many positions from the index on still allow every symbol
+    array<array<int, kSymbols>, kMaxLength + 1> allowedFrom_;
+    // how often every symbol is used by the equation so far
+    array<int, kSymbols> used_;
+    char eq_[kMaxLength];
+};
+
+// everything the hints have told a Board so far
+// trivially copyable, so look-ahead can snapshot and restore it with a memcpy
+struct BoardState {
+    // equation length
+    int length_;
+    // default value for maximum tries
+    size_t defMaxTries;
+    // saves last set of wrongPos symbols
+    array<SymbolPos, kMaxLength> lastWrongPos_;
+    size_t lastWrongPosSize_;
+    // minimum and maximum amount of every symbol in the answer
+    array<int, kSymbols> minCount_;
+    array<int, kSymbols> maxCount_;
+    // how often every symbol is used by the equation currently generated
+    array<int, kSymbols> used_;
+    // all positions and allowed symbols at those positions
+    array<SymbolMask, kMaxLength> allowedAtPos_;
+    // numbers of the random guesses
+    RandomStream random_;
+};
+static_assert(is_trivially_copyable<BoardState>::value,
+    "BoardState has to stay memcpy-able");
+
 // class for keeping track of hints of the nerdle game
 // and generating different steps of equation
 class Board {
  public:
     // For testing:
     FRIEND_TEST(Board, updateUsageCaps);
-    FRIEND_TEST(Board, hasUsageCaps);
+    FRIEND_TEST(Board, minMaxCounts);
     // setup board for given equation length
     // default constructor will use equation length = 8
     Board(const int length = 8);
-    Board &operator=(const Board &b);
-    // Updates the allowed symbols
+    // Updates the allowed symbols and the candidates
     void update(const NerdleStatusRow& row);
+    // only updates the allowed symbols, the candidates stay as they are
+    // (together with snapshot and restore this evaluates hypothetical rows)
+    void updateHints(const NerdleStatusRow& row);
+    // returns the hint state, restore(snapshot()) undoes every updateHints
+    // in between
+    const BoardState& snapshot() const { return state_; }
+    void restore(const BoardState& state) { state_ = state; }
     // return a valid eq based on given hints
     const string getEq();
     // returns an eq where only correct symbols are set, others are '_'
@@ -53,79 +122,99 @@ class Board {
     string getEqAddWP(string eq);
     string getEqGuessRest(string eq);
     string getEqBruteForce(string eq);
+    // evaluates the lhs of eq once and replaces the rhs by its value
+    // returns false (and leaves eq as it is) if the lhs is broken or the
+    // equation with the derived rhs contradicts the hints
+    bool deriveRhs(string* eq) const;
+    // returns the first valid eq (in order of '=' position and symbol index)
+    // that doesnt contradict the hints or "" if there is none
+    // the eq is found by a depth first search, so the time it takes is
+    // bounded and the same hints always give the same eq
+    string getEqSearch() const;
+    // what the board counted so far (see SolverCounters.h)
+    SolverCounters* counters() { return &counters_; }
+    const SolverCounters& counters() const { return counters_; }
+    // returns the counters and resets them to 0
+    SolverCounters takeCounters();
+    // sets the seed of the random guesses (for reproducible runs)
+    void seed(const uint64_t seed) { state_.random_ = RandomStream(seed); }
+    // returns true if eq doesnt contradict the hints collected so far
+    bool isConsistent(const string& eq) const;
+    // same for an equation with the length of the board
+    bool isConsistent(const PackedEquation eq) const;
+    // keep track of all equations of universe that can still be the answer,
+    // every update only has to look at the equations left by the one before
+    void trackCandidates(shared_ptr<const EquationUniverse> universe);
+    // amount of equations that can still be the answer (0 if not tracked)
+    size_t candidateCount() const;
+    // returns equation i (0 to candidateCount() - 1) that can still be the
+    // answer, in the order of the universe
+    string candidate(const size_t i) const {
+        return unpackEquation(packedCandidate(i));
+    }
+    PackedEquation packedCandidate(const size_t i) const {
+        return universe_->packed()[allCandidates_ ? i : candidates_[i]];
+    }
 
  private:
-    // default set of numbers and operations
-    const vector<char> defNums =
-        {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'};
-    const vector<char> defOps = {'+', '-', '*', '/'};
-    // equation length
-    int length_;
-    // default value for maximum tries
-    const size_t defMaxTries;
-    // save if eq was already optimized for =
-    bool equalsFlag = false;
-    // saves last set of wrongPos symbols
-    shared_ptr<vector<SymbolPos>> lastWrongPos_ =
-        make_shared<vector<SymbolPos>>();
-    // saves how often all (non correct) characters are allowed
-    shared_ptr<vector<UsageCap>> usageCaps_;
-    // all positions and allowed characters at those positions
-    shared_ptr<vector<shared_ptr<vector<char>>>> allowedAtPos_;
-    // seed for rand_r
-    unsigned int randSeed = (unsigned int)time(NULL);
+    // hints collected so far
+    BoardState state_;
+    // equations that can still be the answer: all of universe_ until the
+    // first update and the indices in candidates_ afterwards
+    shared_ptr<const EquationUniverse> universe_;
+    bool allCandidates_ = false;
+    vector<uint32_t> candidates_;
+    // bitsets of universe_ (null for universes not shared by
+    // EquationUniverse::get)
+    shared_ptr<const CandidateIndex> index_;
+    // counters of this board (only counting with NERDLE_COUNTERS)
+    SolverCounters counters_;
 
-    // finds correct usagecap and adds 1 to used
+    // adds 1 to the usage of c
     void addUsage(const char c);
     // returns true if symbol is below usage cap i.e. can be used
     bool isUsable(const char c) const;
-    // returns index of usagecap in vector
-    int getUsageCapIndex(const char c) const;
-    // sorts last statusrow into correct wrongpos and wrong
-    void collectResults(const NerdleStatusRow& row,
-        shared_ptr<vector<SymbolPos>> correct,
-        shared_ptr<vector<SymbolPos>> wrongPos,
-        shared_ptr<vector<char>> wrong) const;
-    // checks if usagecap is triggert and what the cap is
-    void hasUsageCaps(const shared_ptr<vector<SymbolPos>> correct,
-        const shared_ptr<vector<SymbolPos>> wrongPos,
-        const shared_ptr<vector<char>> wrong,
-        shared_ptr<vector<SymbolPos>> caps) const;
-    // makes sure that symbols marked as wrong because of amount cap dont get 
-    // deleted completly
-    void filterWrong(shared_ptr<vector<char>> wrong,
-        const shared_ptr<vector<SymbolPos>> caps) const;
+    // counts the hints of last statusrow per symbol
+    void collectResults(const NerdleStatusRow& row, RowCounts* counts) const;
+    // removes all candidates that would not have given the hints of row
+    void filterCandidates(const NerdleStatusRow& row);
+    // same with the bitsets of index_, pays off as long as there is at least
+    // one candidate per 64 equations
+    void filterCandidatesByIndex(const NerdleStatusRow& row);
+    // tightens min and max amount of every symbol
+    void updateUsageCaps(const RowCounts& counts);
     // lock correct chars at their position
-    void lockCorrect(const shared_ptr<vector<SymbolPos>> correct);
+    void lockCorrect(const NerdleStatusRow& row);
+    // delete chars at positions where they arent allowed and remember
+    // wrongpos symbols
+    void deleteWrongPos(const NerdleStatusRow& row);
+    // deletes chars that arent allowed in the equation any more
+    void deleteWrong();
     // optimize allowed symbols to make less wrong guesses
-    void optimizeAllowedAtPos(const shared_ptr<vector<SymbolPos>> correct,
-                                const shared_ptr<vector<SymbolPos>> caps);
+    void optimizeAllowedAtPos(const NerdleStatusRow& row);
     // if optimizeAllowedAtPos has figured out that a lastWrongPos can only be
     // in one spot it will be removed from lastWrong pos because its added
     // always anyway by default to the equaiton
     void optimizeLastWrongPos(const char c);
     // returns true if character at given pos is allowed in equation
-    bool validForEq(const string eq, const size_t pos, const char c) const;
-    // delete chars at positions where they arent allowed
-    void deleteWrongPos(const shared_ptr<vector<SymbolPos>> wrongPos);
-    // deletes chars that arent allowed in the equation
-    void deleteWrong(const shared_ptr<vector<char>> wrong);
-    // updates the usage caps for given symbol index of symbolpos is new cap
-    void updateUsageCaps(const shared_ptr<vector<SymbolPos>> caps);
+    bool validForEq(const string& eq, const size_t pos, const char c) const;
+    // places every possible symbol at pos and continues with pos + 1
+    // returns true as soon as st->eq_ holds a complete equation
+    bool searchFrom(SearchState* st, const int pos, const SearchValue& v) const;
+    // applies the pending op of v to the number that ends before pos and
+    // returns false if that breaks the equation or the rhs cant be reached
+    bool closeNumber(const SearchState& st, const int pos,
+        SearchValue* v) const;
+    // returns true if the missing symbols still fit into the positions from
+    // pos on
+    bool canComplete(const SearchState& st, const int pos) const;
     // reset how often a character is used (needed before a
     // new equation is generated)
     void resetUsage();
-    // returns true if char is in vector
-    bool isInVec(const shared_ptr<vector<char>> vec, const char c) const;
-    // deletes a char from vector of chars (no duplicates) true if item
-    // was deleted
-    bool deleteFromVec(shared_ptr<vector<char>> vec, const char c) const;
-    // delete chars from vector of chars (no duplicates) true if item
-    // was deleted
-    bool deleteFromVec(shared_ptr<vector<char>> vec,
-        shared_ptr<vector<char>> chars) const;
+    // returns a random symbol of mask
+    char randomSymbol(const SymbolMask mask);
     // returns true if char is a number
-    bool isNum(const char c) const;
+    bool isNum(const char c) const { return c >= '0' && c <= '9'; }
     // returns true if char is _
     bool isUnderscore(const char c) const { return  c == '_'; }
 };
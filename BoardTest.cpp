@@ -3,35 +3,58 @@
 
 #include <gtest/gtest.h>
 #include <string>
-#include <memory>
 #include <vector>
 #include "./Board.h"
+#include "./EquationUniverse.h"
+#include "./EquationValidator.h"
 
 using namespace std;  // NOLINT
 
-TEST(Board, hasUsageCaps) {
-    SymbolPos c;
-    c.character_ = '0';
-    c.index_ = 1;
-    SymbolPos wp;
-    wp.character_ = '0';
-    wp.index_ = 2;
-    char w = '0';
-    vector<SymbolPos> correct = {c};
-    vector<SymbolPos> wrongPos = {wp};
-    vector<char> wrong = {w};
-    shared_ptr<vector<SymbolPos>> spCorrect =
-        make_shared<vector<SymbolPos>>(correct);
-    shared_ptr<vector<SymbolPos>> spWrongPos =
-        make_shared<vector<SymbolPos>>(wrongPos);
-    shared_ptr<vector<char>> spWrong =
-        make_shared<vector<char>>(wrong);
-    shared_ptr<vector<SymbolPos>> caps =
-        make_shared<vector<SymbolPos>>();
+// builds a status row from a guess and its hints (C, W, X for correct,
+// wrongpos and wrong)
+NerdleStatusRow makeRow(const string& guess, const string& hints) {
+    NerdleStatusRow row;
+    for (size_t i = 0; i < guess.size(); ++i) {
+        CharacterAndStatus cas;
+        cas.character_ = guess[i];
+        cas.status_ = hints[i] == 'C' ? NerdleStatus::Correct :
+            hints[i] == 'W' ? NerdleStatus::WrongPosition : NerdleStatus::Wrong;
+        row.push_back(cas);
+    }
+    return row;
+}
+
+// returns the hints nerdle gives for guess if answer is the solution
+string hintsFor(const string& guess, const string& answer) {
+    string hints(guess.size(), 'X');
+    array<int, kSymbols> left = {};
+    for (size_t i = 0; i < guess.size(); ++i) {
+        if (guess[i] == answer[i])
+            hints[i] = 'C';
+        else
+            ++left[symbolIndex(answer[i])];
+    }
+    for (size_t i = 0; i < guess.size(); ++i) {
+        if (hints[i] != 'C' && left[symbolIndex(guess[i])] > 0) {
+            hints[i] = 'W';
+            --left[symbolIndex(guess[i])];
+        }
+    }
+    return hints;
+}
+
+TEST(Board, minMaxCounts) {
     Board b(11);
-    b.hasUsageCaps(spCorrect, spWrongPos, spWrong, caps);
-    ASSERT_EQ(caps->at(0).character_, '0');
-    ASSERT_EQ(caps->at(0).index_, 2);
+    b.update(makeRow("100+20*3=60", "CWWXXXXXXXX"));
+    // one correct and one wrongpos 0 plus a wrong one means exactly two
+    ASSERT_EQ(b.state_.minCount_[symbolIndex('0')], 2);
+    ASSERT_EQ(b.state_.maxCount_[symbolIndex('0')], 2);
+    ASSERT_EQ(b.state_.allowedAtPos_[0], symbolBit('1'));
+    ASSERT_EQ(b.state_.allowedAtPos_[1] & symbolBit('0'), 0);
+    // wrong symbols without any other hint are gone everywhere
+    ASSERT_EQ(b.state_.maxCount_[symbolIndex('+')], 0);
+    ASSERT_EQ(b.state_.allowedAtPos_[5] & symbolBit('+'), 0);
+    ASSERT_EQ(b.isConsistent("10+0*5-0=10"), false);
 }
 
 // 1. set cap for 0 to 1
@@ -39,29 +62,156 @@ TEST(Board, hasUsageCaps) {
 // 3. set cap for 0 and 1 (at same time) on new board
 TEST(Board, updateUsageCaps) {
     Board b(11);
-    SymbolPos nCap;
-    nCap.character_ = '0';
-    nCap.index_ = 1;
-    vector<SymbolPos> allNCaps = {nCap};
-    shared_ptr<vector<SymbolPos>> capUpdate =
-        make_shared<vector<SymbolPos>>(allNCaps);
-    b.updateUsageCaps(capUpdate);
-    ASSERT_EQ(b.usageCaps_->at(0).allowed_, 1);
+    RowCounts zeroCap;
+    zeroCap.correct_[0] = 1;
+    zeroCap.wrong_[0] = 1;
+    b.updateUsageCaps(zeroCap);
+    ASSERT_EQ(b.state_.maxCount_[0], 1);
 
-    SymbolPos nCap2;
-    nCap2.character_ = '1';
-    nCap2.index_ = 3;
-    vector<SymbolPos> allNCaps2 = {nCap2};
-    shared_ptr<vector<SymbolPos>> capUpdate2 =
-        make_shared<vector<SymbolPos>>(allNCaps2);
-    b.updateUsageCaps(capUpdate2);
-    ASSERT_EQ(b.usageCaps_->at(1).allowed_, 3);
+    RowCounts oneCap;
+    oneCap.wrongPos_[1] = 3;
+    oneCap.wrong_[1] = 1;
+    b.updateUsageCaps(oneCap);
+    ASSERT_EQ(b.state_.maxCount_[1], 3);
+    ASSERT_EQ(b.state_.minCount_[1], 3);
 
     b = Board(10);
-    allNCaps.push_back(nCap2);
-    shared_ptr<vector<SymbolPos>> capUpdate3 =
-        make_shared<vector<SymbolPos>>(allNCaps);
-    b.updateUsageCaps(capUpdate3);
-    ASSERT_EQ(b.usageCaps_->at(0).allowed_, 1);
-    ASSERT_EQ(b.usageCaps_->at(1).allowed_, 3);
+    zeroCap.wrongPos_[1] = 3;
+    zeroCap.wrong_[1] = 1;
+    b.updateUsageCaps(zeroCap);
+    ASSERT_EQ(b.state_.maxCount_[0], 1);
+    ASSERT_EQ(b.state_.maxCount_[1], 3);
+}
+
+// the search has to find a consistent equation exactly if the universe
+// contains one
+TEST(Board, getEqSearch) {
+    const EquationUniverse& universe = *EquationUniverse::get(8);
+    Board fresh(8);
+    ASSERT_EQ(isValidEquation(fresh.getEqSearch(), 8), true);
+    for (size_t a = 0; a < universe.size(); a += 997) {
+        const string answer = universe.equation(a);
+        Board b(8);
+        string guess = "1+7*9=64";
+        for (int turn = 0; turn < 6 && guess != answer; ++turn) {
+            b.update(makeRow(guess, hintsFor(guess, answer)));
+            guess = b.getEqSearch();
+            ASSERT_EQ(universe.contains(guess), true) << answer;
+            ASSERT_EQ(b.isConsistent(guess), true) << answer;
+            ASSERT_EQ(b.isConsistent(answer), true) << answer;
+        }
+    }
+    // no 1 at all but a correct 1 at the start
+    Board contradiction(8);
+    contradiction.update(makeRow("1+7*9=64", "XXXXXXXX"));
+    contradiction.update(makeRow("12+3=4*5", "CXXXXXXX"));
+    ASSERT_EQ(contradiction.getEqSearch(), "");
+    for (const string& eq : universe.equations())
+        ASSERT_EQ(contradiction.isConsistent(eq), false) << eq;
+}
+
+// the candidates are exactly the equations that give the same hints for
+// every guess
+TEST(Board, trackCandidates) {
+    shared_ptr<const EquationUniverse> universe = EquationUniverse::get(8);
+    Board b(8);
+    ASSERT_EQ(b.candidateCount(), 0u);
+    b.trackCandidates(universe);
+    ASSERT_EQ(b.candidateCount(), universe->size());
+    const string answer = "12+35=47";
+    vector<string> guesses = {"1+7*9=64", "10+2*3=16", "12+34=46"};
+    size_t last = b.candidateCount();
+    for (size_t g = 0; g < guesses.size(); ++g) {
+        b.update(makeRow(guesses[g], hintsFor(guesses[g], answer)));
+        vector<string> expected;
+        for (const string& eq : universe->equations()) {
+            bool same = true;
+            for (size_t h = 0; h <= g; ++h) {
+                same = same && hintsFor(guesses[h], eq) ==
+                    hintsFor(guesses[h], answer);
+            }
+            if (same)
+                expected.push_back(eq);
+        }
+        ASSERT_EQ(b.candidateCount(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+            ASSERT_EQ(b.candidate(i), expected[i]);
+        ASSERT_LT(b.candidateCount(), last);
+        last = b.candidateCount();
+    }
+}
+
+TEST(Board, initialAllowed) {
+    static_assert(kInitialAllowed[8][0] == kNumMask, "");
+    static_assert(kInitialAllowed[8][4] == kAllMask, "");
+    static_assert(kInitialAllowed[8][7] == kNumMask, "");
+    static_assert(isSupportedLength(8) && isSupportedLength(11), "");
+    static_assert(!isSupportedLength(7) && !isSupportedLength(12), "");
+    Board b(10);
+    ASSERT_EQ(b.getEqCO(), "__________");
+    ASSERT_TRUE(b.isConsistent("1234+56=12"));
+    ASSERT_FALSE(b.isConsistent("+123+56=17"));
+    ASSERT_FALSE(b.isConsistent("12=34+5+62"));
+}
+
+// checks every field of two states (memcmp would compare padding too)
+void expectSameState(const BoardState& a, const BoardState& b) {
+    ASSERT_EQ(a.length_, b.length_);
+    ASSERT_EQ(a.defMaxTries, b.defMaxTries);
+    ASSERT_EQ(a.lastWrongPosSize_, b.lastWrongPosSize_);
+    for (size_t i = 0; i < a.lastWrongPosSize_; ++i) {
+        ASSERT_EQ(a.lastWrongPos_[i].character_, b.lastWrongPos_[i].character_);
+        ASSERT_EQ(a.lastWrongPos_[i].index_, b.lastWrongPos_[i].index_);
+    }
+    ASSERT_EQ(a.minCount_, b.minCount_);
+    ASSERT_EQ(a.maxCount_, b.maxCount_);
+    ASSERT_EQ(a.used_, b.used_);
+    ASSERT_EQ(a.allowedAtPos_, b.allowedAtPos_);
+    // same key and counter give the same numbers
+    RandomStream ra = a.random_, rb = b.random_;
+    ASSERT_EQ(ra(), rb());
+}
+
+TEST(Board, snapshotRestore) {
+    Board b(8);
+    b.trackCandidates(EquationUniverse::get(8));
+    b.update(makeRow("12+35=47", hintsFor("12+35=47", "13+24=37")));
+    vector<string> candidates;
+    for (size_t i = 0; i < b.candidateCount(); ++i)
+        candidates.push_back(b.candidate(i));
+    const BoardState before = b.snapshot();
+    const string search = b.getEqSearch();
+    b.updateHints(makeRow(search, "XXXXXXXX"));
+    ASSERT_NE(b.getEqSearch(), search);
+    // the candidates only change with update
+    ASSERT_EQ(b.candidateCount(), candidates.size());
+    b.restore(before);
+    ASSERT_EQ(b.getEqSearch(), search);
+    expectSameState(before, b.snapshot());
+    ASSERT_EQ(b.candidateCount(), candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i)
+        ASSERT_EQ(b.candidate(i), candidates[i]);
+    // copies are independent of each other
+    Board c = b;
+    c.updateHints(makeRow(search, "XXXXXXXX"));
+    ASSERT_EQ(b.getEqSearch(), search);
+}
+
+TEST(Board, deriveRhs) {
+    Board b(8);
+    string eq = "12+35=11";
+    ASSERT_TRUE(b.deriveRhs(&eq));
+    ASSERT_EQ(eq, "12+35=47");
+    // value doesnt fit into the rhs
+    eq = "99+99=11";
+    ASSERT_FALSE(b.deriveRhs(&eq));
+    ASSERT_EQ(eq, "99+99=11");
+    eq = "1+12-0=4";
+    ASSERT_FALSE(b.deriveRhs(&eq));
+    eq = "12*+5=47";
+    ASSERT_FALSE(b.deriveRhs(&eq));
+    // 7 cant be at the last position any more
+    b.update(makeRow("12+35=47", "CCCCCCCX"));
+    eq = "12+35=40";
+    ASSERT_FALSE(b.deriveRhs(&eq));
 }
@@ -0,0 +1,121 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "./CandidateIndex.h"
+
+CandidateIndex::CandidateIndex(const EquationUniverse& universe)
+        : length_(universe.length()), size_(universe.size()),
+        words_((universe.size() + 63) / 64) {
+    const vector<PackedEquation>& eqs = universe.packed();
+    // only bitsets that have a bit set are stored
+    at_.assign(length_ * kSymbols, -1);
+    atLeast_.assign(kSymbols * (kMaxLength + 1), -1);
+    array<int, kSymbols> most = {};
+    for (const PackedEquation eq : eqs) {
+        array<int, kSymbols> count = {};
+        for (int i = 0; i < length_; ++i) {
+            const int s = packedSymbol(eq, i);
+            at_[i * kSymbols + s] = 0;
+            ++count[s];
+        }
+        for (int s = 0; s < kSymbols; ++s)
+            most[s] = max(most[s], count[s]);
+    }
+    int bitsets = 0;
+    for (int& b : at_) {
+        if (b == 0)
+            b = bitsets++;
+    }
+    // at least 0 is true for every equation and needs no bitset
+    for (int s = 0; s < kSymbols; ++s) {
+        for (int k = 1; k <= most[s]; ++k)
+            atLeast_[s * (kMaxLength + 1) + k] = bitsets++;
+    }
+    bits_.assign(bitsets * words_, 0);
+
+    for (size_t e = 0; e < eqs.size(); ++e) {
+        const uint64_t bit = 1ull << (e % 64);
+        array<int, kSymbols> count = {};
+        for (int i = 0; i < length_; ++i) {
+            const int s = packedSymbol(eqs[e], i);
+            bits_[at_[i * kSymbols + s] * words_ + e / 64] |= bit;
+            ++count[s];
+        }
+        for (int s = 0; s < kSymbols; ++s) {
+            for (int k = 1; k <= count[s]; ++k)
+                bits_[atLeast_[s * (kMaxLength + 1) + k] * words_ + e / 64] |=
+                    bit;
+        }
+    }
+}
+
+shared_ptr<const CandidateIndex> CandidateIndex::get(const int length) {
+    static mutex lock;
+    static map<int, shared_ptr<const CandidateIndex>> indices;
+    shared_ptr<const EquationUniverse> universe = EquationUniverse::get(length);
+    lock_guard<mutex> guard(lock);
+    shared_ptr<const CandidateIndex>& index = indices[length];
+    if (!index)
+        index = make_shared<const CandidateIndex>(*universe);
+    return index;
+}
+
+void CandidateIndex::filter(const NerdleStatusRow& row,
+        uint64_t* alive) const {
+    auto clear = [&]() { fill(alive, alive + words_, 0); };
+    auto keep = [&](const int b) {
+        if (b < 0)
+            return clear();
+        const uint64_t* bits = bitset(b);
+        for (size_t w = 0; w < words_; ++w)
+            alive[w] &= bits[w];
+    };
+    auto drop = [&](const int b) {
+        if (b < 0)
+            return;
+        const uint64_t* bits = bitset(b);
+        for (size_t w = 0; w < words_; ++w)
+            alive[w] &= ~bits[w];
+    };
+    if (row.size() != static_cast<size_t>(length_))
+        return clear();
+    // copies of every symbol the answer has for sure and whether that is
+    // all of them
+    array<int, kSymbols> found = {};
+    array<bool, kSymbols> capped = {};
+    for (int i = 0; i < length_; ++i) {
+        const int s = symbolIndex(row[i].character_);
+        if (s < 0)
+            return clear();
+        switch (row[i].status_) {
+            case NerdleStatus::Correct:
+                keep(at_[i * kSymbols + s]);
+                ++found[s];
+                break;
+            case NerdleStatus::WrongPosition:
+                // wrongpos hints go from left to right, so none can follow
+                // a wrong copy of the same symbol
+                if (capped[s])
+                    return clear();
+                drop(at_[i * kSymbols + s]);
+                ++found[s];
+                break;
+            case NerdleStatus::Wrong:
+                drop(at_[i * kSymbols + s]);
+                capped[s] = true;
+                break;
+        }
+    }
+    for (int s = 0; s < kSymbols; ++s) {
+        if (found[s] > 0)
+            keep(atLeast_[s * (kMaxLength + 1) + found[s]]);
+        if (capped[s] && found[s] < kMaxLength)
+            drop(atLeast_[s * (kMaxLength + 1) + found[s] + 1]);
+    }
+}
@@ -0,0 +1,50 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef CANDIDATEINDEX_H_
+#define CANDIDATEINDEX_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "./EquationUniverse.h"
+#include "./NerdleBenchmark.h"
+#include "./NerdleSymbols.h"
+
+using namespace std;  // NOLINT
+
+// inverted index of an equation universe: one bitset (bit e for equation e)
+// per position and symbol at that position and one per symbol and minimum
+// amount of that symbol, so the equations that give the hints of a row are
+// found with a few ANDs over whole bitsets instead of a check per equation
+class CandidateIndex {
+ public:
+    explicit CandidateIndex(const EquationUniverse& universe);
+    // returns the index of EquationUniverse::get(length), it is built on
+    // first request and shared afterwards
+    static shared_ptr<const CandidateIndex> get(const int length);
+    // amount of equations and of 64 bit words per bitset
+    size_t size() const { return size_; }
+    size_t words() const { return words_; }
+    // clears the bits of all equations in alive (words() words) that would
+    // have given other hints than row (a guess and its hints)
+    void filter(const NerdleStatusRow& row, uint64_t* alive) const;
+
+ private:
+    int length_;
+    size_t size_;
+    size_t words_;
+    // bitset number of every position and symbol and of every symbol and
+    // minimum amount (with kMaxLength + 1 amounts per symbol), -1 where no
+    // equation has the bit set
+    vector<int> at_;
+    vector<int> atLeast_;
+    // all bitsets one after another
+    vector<uint64_t> bits_;
+
+    const uint64_t* bitset(const int b) const {
+        return &bits_[b * words_];
+    }
+};
+
+#endif  // CANDIDATEINDEX_H_
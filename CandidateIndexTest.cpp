@@ -0,0 +1,41 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "./CandidateIndex.h"
+#include "./FeedbackPattern.h"
+
+// the bits left are exactly the equations that give the same hints
+TEST(CandidateIndex, filter) {
+    shared_ptr<const EquationUniverse> universe = EquationUniverse::get(8);
+    const vector<PackedEquation>& eqs = universe->packed();
+    shared_ptr<const CandidateIndex> index = CandidateIndex::get(8);
+    ASSERT_EQ(index->size(), eqs.size());
+    ASSERT_EQ(index->words(), (eqs.size() + 63) / 64);
+    for (size_t g = 0; g < eqs.size(); g += 3001) {
+        for (size_t a = 0; a < eqs.size(); a += 2503) {
+            const int pattern = feedbackPattern(eqs[g], eqs[a]);
+            vector<uint64_t> alive(index->words(), ~0ull);
+            index->filter(patternRow(unpackEquation(eqs[g]), pattern),
+                alive.data());
+            for (size_t e = 0; e < eqs.size(); ++e) {
+                ASSERT_EQ((alive[e / 64] >> (e % 64)) & 1,
+                    feedbackPattern(eqs[g], eqs[e]) == pattern)
+                    << unpackEquation(eqs[g]) << " " << unpackEquation(eqs[e]);
+            }
+        }
+    }
+}
+
+// hints nerdle cant show leave nothing
+TEST(CandidateIndex, impossibleRow) {
+    shared_ptr<const CandidateIndex> index = CandidateIndex::get(8);
+    // a wrongpos 1 after a wrong 1
+    const int pattern = 1 * 9;
+    vector<uint64_t> alive(index->words(), ~0ull);
+    index->filter(patternRow("1+1*9=10", pattern), alive.data());
+    for (const uint64_t w : alive)
+        ASSERT_EQ(w, 0u);
+}
@@ -0,0 +1,215 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "./EquationUniverse.h"
+#include "./EquationValidator.h"
+
+EquationUniverse::EquationUniverse(const int length, unsigned int threads)
+        : length_(length) {
+    if (threads == 0)
+        threads = max(1u, thread::hardware_concurrency());
+    vector<UniverseTask> tasks = buildTasks();
+    vector<vector<PackedEquation>> results(tasks.size());
+    atomic<size_t> nextTask(0);
+    auto worker = [&]() {
+        for (size_t i = nextTask++; i < tasks.size(); i = nextTask++) {
+            runTask(tasks.at(i), &results.at(i));
+        }
+    };
+    vector<thread> workers;
+    for (unsigned int i = 1; i < threads; ++i)
+        workers.emplace_back(worker);
+    worker();
+    for (thread& t : workers)
+        t.join();
+
+    size_t total = 0;
+    for (const vector<PackedEquation>& r : results)
+        total += r.size();
+    equations_.reserve(total);
+    for (const vector<PackedEquation>& r : results)
+        equations_.insert(equations_.end(), r.begin(), r.end());
+    // same order as the strings (see PackedEquation.h)
+    sort(equations_.begin(), equations_.end());
+}
+
+shared_ptr<const EquationUniverse> EquationUniverse::get(const int length) {
+    static mutex lock;
+    static map<int, shared_ptr<const EquationUniverse>> universes;
+    lock_guard<mutex> guard(lock);
+    shared_ptr<const EquationUniverse>& u = universes[length];
+    if (!u)
+        u = make_shared<const EquationUniverse>(length);
+    return u;
+}
+
+vector<string> EquationUniverse::equations() const {
+    vector<string> eqs;
+    eqs.reserve(equations_.size());
+    for (const PackedEquation p : equations_)
+        eqs.push_back(unpackEquation(p));
+    return eqs;
+}
+
+bool EquationUniverse::contains(const string& eq) const {
+    if (eq.size() != static_cast<size_t>(length_))
+        return false;
+    return binary_search(equations_.begin(), equations_.end(),
+        packEquation(eq));
+}
+
+vector<UniverseTask> EquationUniverse::buildTasks() const {
+    vector<UniverseTask> tasks;
+    // lhs needs at least "1+1" and rhs at least one digit
+    for (int lhs = 3; lhs <= length_ - 2; ++lhs) {
+        // first number has to leave space for an operator and a number
+        for (int digits = 1; digits <= lhs - 2; ++digits) {
+            for (int lead = digits == 1 ? 0 : 1; lead <= 9; ++lead) {
+                UniverseTask t;
+                t.lhsLength_ = lhs;
+                t.firstDigits_ = digits;
+                t.firstLead_ = lead;
+                tasks.push_back(t);
+            }
+        }
+    }
+    return tasks;
+}
+
+void EquationUniverse::runTask(const UniverseTask& task,
+        vector<PackedEquation>* out) const {
+    string eq(length_, '_');
+    int64_t step = powerOf10(task.firstDigits_ - 1);
+    int64_t first = task.firstLead_ * step;
+    int64_t last = task.firstDigits_ == 1 ? first : first + step - 1;
+    placeDigits(&eq[0], 0, task.firstDigits_, task.lhsLength_, 0, 1, 1, 0,
+        first, last, out);
+}
+
+void EquationUniverse::placeNumber(char* eq, const int pos,
+        const int lhsLength, const int64_t sum, const int sign,
+        const int64_t term, const char op, vector<PackedEquation>* out) const {
+    for (int digits = 1; digits <= lhsLength - pos; ++digits) {
+        // a lone 0 can only start a new term, never be an operand of * or /
+        int64_t first = digits == 1 ? (op == 0 ? 0 : 1) : powerOf10(digits - 1);
+        int64_t last = powerOf10(digits) - 1;
+        placeDigits(eq, pos, digits, lhsLength, sum, sign, term, op, first,
+            last, out);
+    }
+}
+
+void EquationUniverse::placeDigits(char* eq, const int pos, const int digits,
+        const int lhsLength, const int64_t sum, const int sign,
+        const int64_t term, const char op, int64_t first, int64_t last,
+        vector<PackedEquation>* out) const {
+    const int end = pos + digits;
+    const int rest = lhsLength - end;
+    // a single char is not enough for operator and number
+    if (rest == 1)
+        return;
+    const int rhsLength = length_ - 1 - lhsLength;
+    int64_t lo, hi;
+    rhsValues(rhsLength, &lo, &hi);
+
+    if (op == '/') {
+        // only exact divisions are allowed so the divisor is at most term
+        last = min(last, term);
+    } else {
+        // the reachable values grow (sign +) or shrink (sign -) with the
+        // number, so the range of useful numbers can be binary searched
+        auto reachesLo = [&](int64_t n) {
+            int64_t low, high;
+            reachableValues(sum, sign, term * n, rest, &low, &high);
+            return high >= lo;
+        };
+        auto reachesHi = [&](int64_t n) {
+            int64_t low, high;
+            reachableValues(sum, sign, term * n, rest, &low, &high);
+            return low <= hi;
+        };
+        auto firstTrue = [&](int64_t a, int64_t b, auto pred) {
+            while (a < b) {
+                int64_t m = a + (b - a) / 2;
+                if (pred(m))
+                    b = m;
+                else
+                    a = m + 1;
+            }
+            return a;
+        };
+        auto lastTrue = [&](int64_t a, int64_t b, auto pred) {
+            while (a < b) {
+                int64_t m = b - (b - a) / 2;
+                if (pred(m))
+                    a = m;
+                else
+                    b = m - 1;
+            }
+            return a;
+        };
+        if (first > last)
+            return;
+        if (sign > 0) {
+            first = firstTrue(first, last, reachesLo);
+            last = lastTrue(first, last, reachesHi);
+        } else {
+            first = firstTrue(first, last, reachesHi);
+            last = lastTrue(first, last, reachesLo);
+        }
+    }
+
+    for (int64_t n = first; n <= last; ++n) {
+        int64_t t;
+        if (op == '*') {
+            t = term * n;
+        } else if (op == '/') {
+            if (term % n != 0)
+                continue;
+            t = term / n;
+        } else {
+            t = n;
+        }
+        int64_t low, high;
+        reachableValues(sum, sign, t, rest, &low, &high);
+        if (high < lo || low > hi)
+            continue;
+        int64_t v = n;
+        for (int i = end - 1; i >= pos; --i) {
+            eq[i] = '0' + v % 10;
+            v /= 10;
+        }
+        if (rest == 0) {
+            // an equation needs at least one operator
+            if (pos > 0)
+                finish(eq, lhsLength, sum + sign * t, out);
+            continue;
+        }
+        for (char next : {'+', '-', '*', '/'}) {
+            eq[end] = next;
+            if (next == '+' || next == '-') {
+                placeNumber(eq, end + 1, lhsLength, sum + sign * t,
+                    next == '+' ? 1 : -1, 1, 0, out);
+            } else if (t != 0) {
+                placeNumber(eq, end + 1, lhsLength, sum, sign, t, next, out);
+            }
+        }
+    }
+}
+
+void EquationUniverse::finish(char* eq, const int lhsLength,
+        const int64_t value, vector<PackedEquation>* out) const {
+    eq[lhsLength] = '=';
+    int64_t v = value;
+    for (int i = length_ - 1; i > lhsLength; --i) {
+        eq[i] = '0' + v % 10;
+        v /= 10;
+    }
+    out->push_back(packEquation(string_view(eq, length_)));
+}
@@ -0,0 +1,75 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef EQUATIONUNIVERSE_H_
+#define EQUATIONUNIVERSE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "./PackedEquation.h"
+
+using namespace std;  // NOLINT
+
+// one unit of enumeration work: all equations with a given lhs length whose
+// first number has the given amount of digits and starts with given digit
+struct UniverseTask {
+    int lhsLength_;
+    int firstDigits_;
+    int firstLead_;
+};
+
+// complete set of valid nerdle equations for one equation length
+// the rules are the same as in NerdleSolver::checkSyntax and
+// NerdleSolver::checkCorrectEquation: no leading zeros, exactly one '=',
+// digits only on the right side, no adjacent operators, * and / before + and -
+// and every division has to be an integer division
+class EquationUniverse {
+ public:
+    // enumerate all equations of given length using given amount of threads
+    // (0 means one thread per core)
+    explicit EquationUniverse(const int length, unsigned int threads = 0);
+    // returns the universe for given length, it is built on first request and
+    // shared afterwards
+    static shared_ptr<const EquationUniverse> get(const int length);
+    // all equations sorted lexicographically (8 bytes each)
+    const vector<PackedEquation>& packed() const { return equations_; }
+    // returns equation i of packed() as string
+    string equation(const size_t i) const {
+        return unpackEquation(equations_[i]);
+    }
+    // returns a copy of all equations as strings
+    vector<string> equations() const;
+    size_t size() const { return equations_.size(); }
+    int length() const { return length_; }
+    // returns true if eq is part of the universe
+    bool contains(const string& eq) const;
+
+ private:
+    // equation length
+    int length_;
+    // all valid equations
+    vector<PackedEquation> equations_;
+
+    // collects all tasks needed to enumerate the universe
+    vector<UniverseTask> buildTasks() const;
+    // enumerates all equations belonging to one task
+    void runTask(const UniverseTask& task, vector<PackedEquation>* out) const;
+    // tries all number lengths for the next number of the lhs at pos
+    // sum is the value of all finished terms, term the value of the current
+    // term (before op is applied to the next number) and sign its sign
+    void placeNumber(char* eq, const int pos, const int lhsLength,
+        const int64_t sum, const int sign, const int64_t term, const char op,
+        vector<PackedEquation>* out) const;
+    // tries all numbers between first and last (all with digits digits) at pos
+    void placeDigits(char* eq, const int pos, const int digits,
+        const int lhsLength, const int64_t sum, const int sign,
+        const int64_t term, const char op, int64_t first, int64_t last,
+        vector<PackedEquation>* out) const;
+    // writes rhs for given value and saves the equation
+    void finish(char* eq, const int lhsLength, const int64_t value,
+        vector<PackedEquation>* out) const;
+};
+
+#endif  // EQUATIONUNIVERSE_H_
@@ -0,0 +1,26 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <gtest/gtest.h>
+#include <string>
+#include "./EquationUniverse.h"
+
+TEST(EquationUniverse, equations) {
+    EquationUniverse u(8);
+    ASSERT_EQ(u.size(), 18290u);
+    ASSERT_EQ(u.contains("1+7*9=64"), true);
+    ASSERT_EQ(u.contains("0+10-9=1"), true);
+    ASSERT_EQ(u.contains("1-9+10=2"), true);
+    // leading zero, zero operand, non integer division, wrong value
+    ASSERT_EQ(u.contains("05+45=50"), false);
+    ASSERT_EQ(u.contains("0*5+12=12"), false);
+    ASSERT_EQ(u.contains("10/4*2=5"), false);
+    ASSERT_EQ(u.contains("45+45=91"), false);
+}
+
+TEST(EquationUniverse, threads) {
+    EquationUniverse single(9, 1);
+    EquationUniverse multi(9, 4);
+    ASSERT_EQ(single.equations(), multi.equations());
+    ASSERT_EQ(EquationUniverse::get(9)->size(), single.size());
+}
@@ -0,0 +1,134 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <cstdint>
+#include "./EquationValidator.h"
+#include "./NerdleGrammar.h"
+
+// combines term with the next number as op says (just num if there is no
+// op), returns false for 0 operands of * and / and non integer divisions
+static bool applyOp(const char op, const int64_t num, int64_t* term) {
+    if (op == '*') {
+        if (*term == 0 || num == 0)
+            return false;
+        *term *= num;
+    } else if (op == '/') {
+        if (*term == 0 || num == 0 || *term % num != 0)
+            return false;
+        *term /= num;
+    } else {
+        *term = num;
+    }
+    return true;
+}
+
+// steps the grammar over eq and evaluates it on the way
+// writes the last state, the value of the lhs, the number on the rhs and the
+// amount of operators and returns Syntax as soon as the grammar is left and
+// Value as soon as an lhs term cant be computed
+static EquationError evaluate(const string_view eq, GrammarState* state,
+        int64_t* lhs, int64_t* rhs, int* ops) {
+    // value of all finished terms and sign of the current term
+    int64_t sum = 0;
+    int sign = 1;
+    // value of current term and op that combines it with the current number
+    int64_t term = 0;
+    char op = 0;
+    int64_t num = 0;
+    GrammarState s = GrammarState::Operand;
+    *ops = 0;
+    for (const char c : eq) {
+        const GrammarState next = grammarStep(s, c);
+        if (next == GrammarState::Dead)
+            return EquationError::Syntax;
+        if (c >= '0' && c <= '9') {
+            num = num * 10 + (c - '0');
+        } else if (s == GrammarState::Zero || s == GrammarState::Number) {
+            // c ends an lhs number
+            if (!applyOp(op, num, &term))
+                return EquationError::Value;
+            num = 0;
+            if (c == '+' || c == '-') {
+                sum += sign * term;
+                sign = c == '+' ? 1 : -1;
+                op = 0;
+                ++*ops;
+            } else if (c == '*' || c == '/') {
+                op = c;
+                ++*ops;
+            } else {
+                sum += sign * term;
+            }
+        }
+        s = next;
+    }
+    if (s == GrammarState::Zero || s == GrammarState::Number) {
+        // eq is an lhs only
+        if (!applyOp(op, num, &term))
+            return EquationError::Value;
+        sum += sign * term;
+        num = 0;
+    }
+    *state = s;
+    *lhs = sum;
+    *rhs = num;
+    return EquationError::None;
+}
+
+EquationError equationError(const string_view eq, const size_t length) {
+    if (eq.size() != length || length == 0)
+        return EquationError::Syntax;
+    GrammarState state;
+    int64_t lhs, rhs;
+    int ops;
+    EquationError error = evaluate(eq, &state, &lhs, &rhs, &ops);
+    if (error != EquationError::None)
+        return error;
+    if (!isAccepting(state))
+        return EquationError::Syntax;
+    // the rhs has to match the lhs
+    if (ops == 0 || lhs != rhs)
+        return EquationError::Value;
+    return EquationError::None;
+}
+
+EquationError lhsValue(const string_view lhs, int64_t* value, int* ops) {
+    GrammarState state;
+    int64_t rhs;
+    EquationError error = evaluate(lhs, &state, value, &rhs, ops);
+    if (error != EquationError::None)
+        return error;
+    if (state != GrammarState::Zero && state != GrammarState::Number)
+        return EquationError::Syntax;
+    return EquationError::None;
+}
+
+int64_t powerOf10(const int e) {
+    int64_t p = 1;
+    for (int i = 0; i < e; ++i)
+        p *= 10;
+    return p;
+}
+
+void reachableValues(const int64_t sum, const int sign, const int64_t term,
+        const int rest, int64_t* low, int64_t* high) {
+    if (rest == 0) {
+        *low = *high = sum + sign * term;
+        return;
+    }
+    // rest chars can multiply or divide the term by less than b and the
+    // following terms add up to less than b
+    int64_t b = powerOf10(rest - 1);
+    if (sign > 0) {
+        *low = sum + term / b - b;
+        *high = sum + term * b + b;
+    } else {
+        *low = sum - term * b - b;
+        *high = sum - term / b + b;
+    }
+}
+
+void rhsValues(const int digits, int64_t* low, int64_t* high) {
+    *low = digits == 1 ? 0 : powerOf10(digits - 1);
+    *high = powerOf10(digits) - 1;
+}
@@ -0,0 +1,50 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef EQUATIONVALIDATOR_H_
+#define EQUATIONVALIDATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+using namespace std;  // NOLINT
+
+// first rule an equation breaks
+// Syntax: the checks of NerdleSolver::checkSyntax (and the length)
+// Value: the checks of NerdleSolver::checkCorrectEquation
+enum class EquationError {
+    None, Syntax, Value
+};
+
+// returns the first rule eq breaks as nerdle equation of given length
+// syntax and value are checked in a single pass without any allocation and
+// the check stops at the first violation
+// it accepts exactly the equations that pass both NerdleSolver::checkSyntax
+// and NerdleSolver::checkCorrectEquation, i.e. * and / before + and -,
+// only integer divisions and no 0 as operand of * or /
+EquationError equationError(const string_view eq, const size_t length);
+
+// evaluates the lhs of an equation (everything before '=') with the same
+// rules as equationError, stores its value and amount of operators in value
+// and ops and returns the first rule lhs breaks
+EquationError lhsValue(const string_view lhs, int64_t* value, int* ops);
+
+// returns true if eq is a correct nerdle equation of given length
+inline bool isValidEquation(const string_view eq, const size_t length) {
+    return equationError(eq, length) == EquationError::None;
+}
+
+// returns 10^e
+int64_t powerOf10(const int e);
+
+// lowest and highest value an lhs can still reach if sum is the value of all
+// finished terms, term the value of the current term with given sign and rest
+// chars of the lhs are left (rest includes the next operator)
+void reachableValues(const int64_t sum, const int sign, const int64_t term,
+    const int rest, int64_t* low, int64_t* high);
+
+// smallest and biggest value a rhs with given amount of digits can show
+void rhsValues(const int digits, int64_t* low, int64_t* high);
+
+#endif  // EQUATIONVALIDATOR_H_
@@ -0,0 +1,61 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "./EquationUniverse.h"
+#include "./FeedbackKernel.h"
+#include "./FeedbackPattern.h"
+
+// prints how long computing the patterns of some guesses against every
+// equation of the universe takes with each implementation
+int main(int argc, char** argv) {
+    if (argc != 2 && argc != 3) {
+        std::cerr << "Usage ./FeedbackBenchmarkMain <lengthOfExpressions> "
+            << "[guesses]" << std::endl;
+        std::exit(1);
+    }
+    const int length = std::atoi(argv[1]);
+    if (!isSupportedLength(length)) {
+        std::cerr << "Unsupported length " << argv[1] << std::endl;
+        std::exit(1);
+    }
+    const size_t guesses = argc == 3 ? std::atoi(argv[2]) : 20;
+    shared_ptr<const EquationUniverse> universe = EquationUniverse::get(length);
+    const vector<string> eqs = universe->equations();
+    PackedEquations packed(length);
+    packed.reserve(eqs.size());
+    for (const PackedEquation eq : universe->packed())
+        packed.add(eq);
+    vector<uint32_t> out(eqs.size());
+
+    auto measure = [&](const string& name, auto kernel) {
+        uint64_t checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t g = 0; g < guesses; ++g) {
+            kernel(eqs[g * eqs.size() / guesses]);
+            for (uint32_t p : out)
+                checksum += p;
+        }
+        std::chrono::duration<double> time =
+            std::chrono::steady_clock::now() - start;
+        std::cout << name << ": " << time.count() * 1e9 / guesses / eqs.size()
+            << " ns per pair (checksum " << checksum << ")" << std::endl;
+    };
+    measure("reference", [&](const string& guess) {
+        for (size_t a = 0; a < eqs.size(); ++a)
+            out[a] = feedbackPattern(guess, eqs[a]);
+    });
+    measure("scalar", [&](const string& guess) {
+        feedbackPatternsScalar(guess, packed, out.data());
+    });
+    if (hasAvx2Kernel()) {
+        measure("avx2", [&](const string& guess) {
+            feedbackPatterns(guess, packed, out.data());
+        });
+    }
+}
@@ -0,0 +1,174 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+#include <array>
+#include <cstdint>
+#include "./FeedbackKernel.h"
+#include "./NerdleSymbols.h"
+
+namespace {
+// sum of 3^i over all set bits i of a byte, shifted by 0 or 8 positions
+struct PowerTables {
+    array<uint32_t, 256> low_;
+    array<uint32_t, 256> high_;
+};
+
+constexpr PowerTables makePowerTables() {
+    PowerTables t = {};
+    for (int m = 0; m < 256; ++m) {
+        uint32_t p = 1;
+        for (int i = 0; i < 8; ++i, p *= 3) {
+            if (m & (1 << i))
+                t.low_[m] += p;
+        }
+        for (int i = 0; i < 8; ++i, p *= 3) {
+            if (m & (1 << i))
+                t.high_[m] += p;
+        }
+    }
+    return t;
+}
+
+constexpr PowerTables kPowers = makePowerTables();
+
+// returns the sum of 3^i over all set bits i of mask
+inline uint32_t powerSum(const uint32_t mask) {
+    return kPowers.low_[mask & 0xFF] + kPowers.high_[(mask >> 8) & 0xFF];
+}
+
+// everything about the guess that doesnt depend on the answer
+struct GuessInfo {
+    int length_;
+    uint8_t row_[kPackedStride];
+    // positions j < i where the guess has the same symbol as at i
+    uint32_t before_[kPackedStride];
+};
+
+GuessInfo prepareGuess(const string_view guess) {
+    GuessInfo g;
+    g.length_ = guess.size();
+    for (int i = 0; i < kPackedStride; ++i) {
+        // differs from the 0xFF the answers are padded with
+        g.row_[i] = i < g.length_ ? symbolIndex(guess[i]) : 0xFE;
+        g.before_[i] = 0;
+        for (int j = 0; j < i && i < g.length_; ++j) {
+            if (g.row_[j] == g.row_[i])
+                g.before_[i] |= 1u << j;
+        }
+    }
+    return g;
+}
+
+uint32_t scalarPattern(const GuessInfo& g, const uint8_t* answer) {
+    uint32_t correct = 0;
+    uint8_t left[kSymbols] = {};
+    for (int i = 0; i < g.length_; ++i) {
+        if (answer[i] == g.row_[i])
+            correct |= 1u << i;
+        else
+            ++left[answer[i]];
+    }
+    uint32_t wrongPos = 0;
+    for (int i = 0; i < g.length_; ++i) {
+        if (!(correct & (1u << i)) && left[g.row_[i]] > 0) {
+            --left[g.row_[i]];
+            wrongPos |= 1u << i;
+        }
+    }
+    return 2 * powerSum(correct) + powerSum(wrongPos);
+}
+
+#if defined(__x86_64__)
+// pattern of one answer given a mask of correct positions and per guess
+// position the mask of answer positions holding the same symbol
+// the symbol at position i is wrongpos if the answer has more copies of it
+// outside the correct positions than the guess has before i
+inline uint32_t patternFromMasks(const GuessInfo& g, const uint32_t correct,
+        const uint32_t* same) {
+    uint32_t wrongPos = 0;
+    const uint32_t open = ~correct;
+    for (int i = 0; i < g.length_; ++i) {
+        if (__builtin_popcount(same[i] & open) >
+                __builtin_popcount(g.before_[i] & open))
+            wrongPos |= 1u << i;
+    }
+    wrongPos &= open;
+    return 2 * powerSum(correct) + powerSum(wrongPos);
+}
+
+// two answers per iteration, one in each 128 bit lane
+__attribute__((target("avx2,popcnt")))
+void avx2Patterns(const GuessInfo& g, const PackedEquations& answers,
+        uint32_t* out) {
+    const size_t pairs = answers.size() / 2;
+    const __m256i guess = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(g.row_)));
+    __m256i symbol[kPackedStride];
+    for (int i = 0; i < g.length_; ++i)
+        symbol[i] = _mm256_set1_epi8(g.row_[i]);
+    for (size_t p = 0; p < pairs; ++p) {
+        const __m256i a = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(answers.row(2 * p)));
+        const uint32_t correct = _mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(a, guess));
+        uint32_t same0[kPackedStride];
+        uint32_t same1[kPackedStride];
+        for (int i = 0; i < g.length_; ++i) {
+            const uint32_t m = _mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(a, symbol[i]));
+            same0[i] = m & 0xFFFF;
+            same1[i] = m >> 16;
+        }
+        out[2 * p] = patternFromMasks(g, correct & 0xFFFF, same0);
+        out[2 * p + 1] = patternFromMasks(g, correct >> 16, same1);
+    }
+    if (answers.size() % 2)
+        out[answers.size() - 1] = scalarPattern(g, answers.row(2 * pairs));
+}
+#endif
+}  // namespace
+
+void PackedEquations::add(const string_view eq) {
+    for (int i = 0; i < kPackedStride; ++i) {
+        rows_.push_back(i < length_ ?
+            static_cast<uint8_t>(symbolIndex(eq[i])) : 0xFF);
+    }
+}
+
+void PackedEquations::add(const PackedEquation eq) {
+    for (int i = 0; i < kPackedStride; ++i) {
+        rows_.push_back(i < length_ ?
+            static_cast<uint8_t>(packedSymbol(eq, i)) : 0xFF);
+    }
+}
+
+void feedbackPatterns(const string_view guess, const PackedEquations& answers,
+        uint32_t* out) {
+#if defined(__x86_64__)
+    if (hasAvx2Kernel()) {
+        avx2Patterns(prepareGuess(guess), answers, out);
+        return;
+    }
+#endif
+    feedbackPatternsScalar(guess, answers, out);
+}
+
+void feedbackPatternsScalar(const string_view guess,
+        const PackedEquations& answers, uint32_t* out) {
+    const GuessInfo g = prepareGuess(guess);
+    for (size_t a = 0; a < answers.size(); ++a)
+        out[a] = scalarPattern(g, answers.row(a));
+}
+
+bool hasAvx2Kernel() {
+#if defined(__x86_64__)
+    static const bool avx2 = __builtin_cpu_supports("avx2") &&
+        __builtin_cpu_supports("popcnt");
+    return avx2;
+#else
+    return false;
+#endif
+}
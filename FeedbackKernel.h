@@ -0,0 +1,52 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef FEEDBACKKERNEL_H_
+#define FEEDBACKKERNEL_H_
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "./PackedEquation.h"
+
+using namespace std;  // NOLINT
+
+// bytes per equation in PackedEquations, a row of 16 bytes fits into one
+// vector register
+constexpr int kPackedStride = 16;
+
+// equations of one length stored as symbol indices (see NerdleSymbols.h),
+// one row of kPackedStride bytes each and unused bytes set to 0xFF
+class PackedEquations {
+ public:
+    explicit PackedEquations(const int length) : length_(length) {}
+    // appends eq, which has to have the given length
+    void add(const string_view eq);
+    // appends eq, which has to have the given length
+    void add(const PackedEquation eq);
+    void reserve(const size_t size) { rows_.reserve(size * kPackedStride); }
+    size_t size() const { return rows_.size() / kPackedStride; }
+    int length() const { return length_; }
+    const uint8_t* row(const size_t i) const {
+        return &rows_[i * kPackedStride];
+    }
+
+ private:
+    int length_;
+    vector<uint8_t> rows_;
+};
+
+// writes the pattern (see FeedbackPattern.h) of guess against every answer
+// to out, which needs space for answers.size() patterns
+// uses AVX2 if the cpu supports it and the scalar kernel otherwise
+void feedbackPatterns(const string_view guess, const PackedEquations& answers,
+    uint32_t* out);
+
+// same as feedbackPatterns but never uses vector instructions
+void feedbackPatternsScalar(const string_view guess,
+    const PackedEquations& answers, uint32_t* out);
+
+// returns true if feedbackPatterns can use AVX2 on this cpu
+bool hasAvx2Kernel();
+
+#endif  // FEEDBACKKERNEL_H_
@@ -0,0 +1,68 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "./FeedbackKernel.h"
+#include "./FeedbackPattern.h"
+#include "./EquationUniverse.h"
+
+// checks both kernels against feedbackPattern for guess and all answers
+void expectKernelsMatch(const string& guess, const vector<string>& answers,
+        const PackedEquations& packed) {
+    vector<uint32_t> fast(answers.size());
+    vector<uint32_t> scalar(answers.size());
+    feedbackPatterns(guess, packed, fast.data());
+    feedbackPatternsScalar(guess, packed, scalar.data());
+    for (size_t a = 0; a < answers.size(); ++a) {
+        uint32_t expected = feedbackPattern(guess, answers[a]);
+        ASSERT_EQ(fast[a], expected) << guess << " " << answers[a];
+        ASSERT_EQ(scalar[a], expected) << guess << " " << answers[a];
+    }
+}
+
+// every pair of strings of length 5 over 5 symbols, which covers every way
+// symbols can repeat inside guess and answer
+TEST(FeedbackKernel, allPairs) {
+    const string symbols = "1+=0*";
+    vector<string> strings;
+    for (int n = 0; n < 5 * 5 * 5 * 5 * 5; ++n) {
+        string s;
+        for (int i = 0, m = n; i < 5; ++i, m /= 5)
+            s.push_back(symbols[m % 5]);
+        strings.push_back(s);
+    }
+    PackedEquations packed(5);
+    for (const string& s : strings)
+        packed.add(s);
+    for (const string& guess : strings)
+        expectKernelsMatch(guess, strings, packed);
+}
+
+// equations of length 11 need patterns bigger than 16 bits
+TEST(FeedbackKernel, equations) {
+    for (int length : {8, 11}) {
+        shared_ptr<const EquationUniverse> universe =
+            EquationUniverse::get(length);
+        // all equations of length 8 and every 97th of length 11 (plus strings
+        // with many repeated symbols)
+        vector<string> answers;
+        const size_t stride = length == 8 ? 1 : 97;
+        for (size_t a = 0; a < universe->size(); a += stride)
+            answers.push_back(universe->equation(a));
+        if (length == 11) {
+            for (const string s : {"1111111=111", "=+-*/012345"})
+                answers.push_back(s);
+        }
+        PackedEquations packed(length);
+        for (const string& a : answers)
+            packed.add(a);
+        ASSERT_EQ(packed.size(), answers.size());
+        const size_t guesses = 40;
+        for (size_t g = 0; g < guesses; ++g)
+            expectKernelsMatch(answers[g * answers.size() / guesses], answers,
+                packed);
+    }
+}
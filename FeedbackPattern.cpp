@@ -0,0 +1,110 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <array>
+#include <string>
+#include "./FeedbackPattern.h"
+#include "./NerdleSymbols.h"
+
+int feedbackPattern(const string_view guess, const string_view answer) {
+    array<int, kSymbols> left = {};
+    array<int, kMaxLength> status = {};
+    const size_t length = guess.size();
+    for (size_t i = 0; i < length; ++i) {
+        if (guess[i] == answer[i])
+            status[i] = 2;
+        else
+            ++left[symbolIndex(answer[i])];
+    }
+    // wrongpos hints are given from left to right
+    for (size_t i = 0; i < length; ++i) {
+        if (status[i] == 2)
+            continue;
+        int& l = left[symbolIndex(guess[i])];
+        if (l > 0) {
+            --l;
+            status[i] = 1;
+        }
+    }
+    int pattern = 0;
+    for (size_t i = length; i-- > 0;)
+        pattern = pattern * 3 + status[i];
+    return pattern;
+}
+
+int feedbackPattern(const PackedEquation guess, const PackedEquation answer) {
+    // a nibble of 0 marks a correct position, padding is equal in both
+    const int length = packedLength(guess);
+    const PackedEquation same = guess ^ answer;
+    array<int, 16> left = {};
+    array<int, kMaxLength> status = {};
+    for (int i = 0; i < length; ++i) {
+        if (packedAt(same, i) == 0)
+            status[i] = 2;
+        else
+            ++left[packedAt(answer, i)];
+    }
+    for (int i = 0; i < length; ++i) {
+        if (status[i] == 2)
+            continue;
+        int& l = left[packedAt(guess, i)];
+        if (l > 0) {
+            --l;
+            status[i] = 1;
+        }
+    }
+    int pattern = 0;
+    for (int i = length; i-- > 0;)
+        pattern = pattern * 3 + status[i];
+    return pattern;
+}
+
+int patternCount(const int length) {
+    int count = 1;
+    for (int i = 0; i < length; ++i)
+        count *= 3;
+    return count;
+}
+
+int rowPattern(const NerdleStatusRow& row) {
+    int pattern = 0;
+    for (size_t i = row.size(); i-- > 0;) {
+        pattern *= 3;
+        switch (row[i].status_) {
+            case NerdleStatus::Correct:
+                pattern += 2;
+                break;
+            case NerdleStatus::WrongPosition:
+                pattern += 1;
+                break;
+            case NerdleStatus::Wrong:
+                break;
+        }
+    }
+    return pattern;
+}
+
+NerdleStatusRow patternRow(const string& guess, int pattern) {
+    NerdleStatusRow row;
+    for (const char c : guess) {
+        CharacterAndStatus cas;
+        cas.character_ = c;
+        switch (pattern % 3) {
+            case 2:
+                cas.status_ = NerdleStatus::Correct;
+                break;
+            case 1:
+                cas.status_ = NerdleStatus::WrongPosition;
+                break;
+            default:
+                cas.status_ = NerdleStatus::Wrong;
+        }
+        row.push_back(cas);
+        pattern /= 3;
+    }
+    return row;
+}
+
+bool isWinPattern(const int pattern, const int length) {
+    return pattern == patternCount(length) - 1;
+}
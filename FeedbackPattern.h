@@ -0,0 +1,37 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef FEEDBACKPATTERN_H_
+#define FEEDBACKPATTERN_H_
+
+#include <string>
+#include <string_view>
+#include "./NerdleBenchmark.h"
+#include "./PackedEquation.h"
+
+using namespace std;  // NOLINT
+
+// the hints of one row encoded as a base 3 number where the digit of
+// position i is 0 for Wrong, 1 for WrongPosition and 2 for Correct
+// (the lowest digit belongs to position 0)
+
+// returns the pattern nerdle shows for guess if answer is the solution
+// symbols are correct first, the remaining copies of a symbol in the answer
+// are then given to its wrongpos symbols from left to right
+int feedbackPattern(const string_view guess, const string_view answer);
+// same for packed equations of the same length
+int feedbackPattern(const PackedEquation guess, const PackedEquation answer);
+
+// returns the amount of different patterns for given equation length (3^n)
+int patternCount(const int length);
+
+// returns the pattern of the hints in row
+int rowPattern(const NerdleStatusRow& row);
+
+// returns the row nerdle shows for guess and given pattern
+NerdleStatusRow patternRow(const string& guess, int pattern);
+
+// returns true if pattern means that every symbol was correct
+bool isWinPattern(const int pattern, const int length);
+
+#endif  // FEEDBACKPATTERN_H_
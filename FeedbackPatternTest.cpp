@@ -0,0 +1,36 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <gtest/gtest.h>
+#include <string>
+#include "./FeedbackPattern.h"
+
+// returns pattern of hints (C, W, X for correct, wrongpos and wrong)
+int hintPattern(const string& hints) {
+    int pattern = 0;
+    for (size_t i = hints.size(); i-- > 0;)
+        pattern = pattern * 3 + (hints[i] == 'C' ? 2 : hints[i] == 'W');
+    return pattern;
+}
+
+TEST(FeedbackPattern, feedbackPattern) {
+    ASSERT_EQ(feedbackPattern("1+7*9=64", "1+7*9=64"), hintPattern("CCCCCCCC"));
+    ASSERT_EQ(isWinPattern(feedbackPattern("1+7*9=64", "1+7*9=64"), 8), true);
+    ASSERT_EQ(feedbackPattern("1+7*9=64", "12+35=47"),
+        hintPattern("CWWXXCXW"));
+    // only as many wrongpos hints as copies left in the answer, left first
+    ASSERT_EQ(feedbackPattern("11+11=22", "10+21=31"),
+        hintPattern("CWCXCCWX"));
+    ASSERT_EQ(feedbackPattern("111*1=111", "11*10=110"),
+        hintPattern("CCWWXCCCX"));
+}
+
+TEST(FeedbackPattern, rows) {
+    const string guess = "20+7*9=83";
+    for (int p = 0; p < patternCount(9); p += 97) {
+        NerdleStatusRow row = patternRow(guess, p);
+        ASSERT_EQ(row.size(), guess.size());
+        ASSERT_EQ(row[3].character_, '7');
+        ASSERT_EQ(rowPattern(row), p);
+    }
+}
@@ -0,0 +1,88 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include "./GuessCache.h"
+
+GuessCache::GuessCache(const size_t capacity, const unsigned int shards) {
+    const size_t count = max(1u, shards);
+    shardCapacity_ = max<size_t>(1, capacity / count);
+    for (size_t i = 0; i < count; ++i) {
+        shards_.push_back(make_unique<Shard>());
+        shards_.back()->entries_.reserve(shardCapacity_);
+    }
+}
+
+string GuessCache::key(const NerdleGameState& gameState) {
+    string k;
+    for (const NerdleStatusRow& row : gameState) {
+        for (const CharacterAndStatus& cas : row) {
+            k.push_back(cas.character_);
+            k.push_back('0' + static_cast<int>(cas.status_));
+        }
+        k.push_back('|');
+    }
+    return k;
+}
+
+bool GuessCache::find(const string& key, string* guess) {
+    Shard& s = shard(key);
+    {
+        lock_guard<mutex> guard(s.lock_);
+        auto it = s.index_.find(key);
+        if (it != s.index_.end()) {
+            Entry& e = s.entries_[it->second];
+            e.referenced_ = true;
+            *guess = e.guess_;
+            ++hits_;
+            return true;
+        }
+    }
+    ++misses_;
+    return false;
+}
+
+void GuessCache::insert(const string& key, const string& guess) {
+    Shard& s = shard(key);
+    lock_guard<mutex> guard(s.lock_);
+    auto it = s.index_.find(key);
+    if (it != s.index_.end()) {
+        s.entries_[it->second].guess_ = guess;
+        return;
+    }
+    if (s.entries_.size() < shardCapacity_) {
+        s.index_.emplace(key, s.entries_.size());
+        s.entries_.push_back({key, guess, false});
+        return;
+    }
+    // the hand clears referenced entries until it finds one that wasnt used
+    // since its last round
+    while (s.entries_[s.hand_].referenced_) {
+        s.entries_[s.hand_].referenced_ = false;
+        s.hand_ = (s.hand_ + 1) % s.entries_.size();
+    }
+    Entry& victim = s.entries_[s.hand_];
+    s.index_.erase(victim.key_);
+    victim = {key, guess, false};
+    s.index_.emplace(key, s.hand_);
+    s.hand_ = (s.hand_ + 1) % s.entries_.size();
+}
+
+size_t GuessCache::size() const {
+    size_t total = 0;
+    for (const unique_ptr<Shard>& s : shards_) {
+        lock_guard<mutex> guard(s->lock_);
+        total += s->entries_.size();
+    }
+    return total;
+}
+
+string GuessCache::toJson() const {
+    ostringstream out;
+    out << "{\"hits\": " << hits_ << ", \"misses\": " << misses_
+        << ", \"size\": " << size() << ", \"capacity\": " << capacity()
+        << "}";
+    return out.str();
+}
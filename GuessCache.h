@@ -0,0 +1,69 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef GUESSCACHE_H_
+#define GUESSCACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "./NerdleBenchmark.h"
+
+using namespace std;  // NOLINT
+
+// bounded cache from the (guess, hints) rows of a game to the guess a solver
+// chose for it, so games that went the same way dont compute it again
+// the entries are spread over shards with one lock each and every shard
+// evicts with the CLOCK algorithm (second chance for entries used since the
+// hand passed them)
+// all methods can be called from any amount of threads at the same time
+// a cache must only be used by solvers with the same engine
+class GuessCache {
+ public:
+    // keeps at most capacity entries (at least one per shard)
+    explicit GuessCache(const size_t capacity, const unsigned int shards = 16);
+    // returns the normalized key of gameState: the guess and status of every
+    // row
+    static string key(const NerdleGameState& gameState);
+    // writes the guess cached for key to guess and returns true if there is
+    // one
+    bool find(const string& key, string* guess);
+    // caches guess for key (replacing what was cached for key before)
+    void insert(const string& key, const string& guess);
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+    // amount of cached entries
+    size_t size() const;
+    size_t capacity() const { return shards_.size() * shardCapacity_; }
+    // hits, misses and size as json
+    string toJson() const;
+
+ private:
+    struct Entry {
+        string key_;
+        string guess_;
+        // set by find, cleared when the clock hand passes
+        bool referenced_;
+    };
+    struct Shard {
+        mutable mutex lock_;
+        vector<Entry> entries_;
+        // index of every key in entries_
+        unordered_map<string, size_t> index_;
+        size_t hand_ = 0;
+    };
+    vector<unique_ptr<Shard>> shards_;
+    size_t shardCapacity_;
+    atomic<uint64_t> hits_{0};
+    atomic<uint64_t> misses_{0};
+
+    Shard& shard(const string& key) {
+        return *shards_[hash<string>()(key) % shards_.size()];
+    }
+};
+
+#endif  // GUESSCACHE_H_
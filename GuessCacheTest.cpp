@@ -0,0 +1,67 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "./GuessCache.h"
+#include "./HeadlessBenchmark.h"
+#include "./NerdleSolver.h"
+
+TEST(GuessCache, findInsert) {
+    GuessCache cache(4, 1);
+    string guess;
+    ASSERT_FALSE(cache.find("a", &guess));
+    cache.insert("a", "12+35=47");
+    ASSERT_TRUE(cache.find("a", &guess));
+    ASSERT_EQ(guess, "12+35=47");
+    cache.insert("a", "45+45=90");
+    ASSERT_TRUE(cache.find("a", &guess));
+    ASSERT_EQ(guess, "45+45=90");
+    ASSERT_EQ(cache.hits(), 2u);
+    ASSERT_EQ(cache.misses(), 1u);
+    ASSERT_EQ(cache.size(), 1u);
+
+    NerdleGameState state = {hintRow("12+35=47", "45+45=90")};
+    ASSERT_EQ(GuessCache::key(state), "1222+03250=04172|");
+}
+
+TEST(GuessCache, clockEviction) {
+    GuessCache cache(3, 1);
+    for (const char* k : {"a", "b", "c"})
+        cache.insert(k, k);
+    string guess;
+    // a gets a second chance, so b is the first one without
+    ASSERT_TRUE(cache.find("a", &guess));
+    cache.insert("d", "d");
+    ASSERT_EQ(cache.size(), 3u);
+    ASSERT_TRUE(cache.find("a", &guess));
+    ASSERT_FALSE(cache.find("b", &guess));
+    ASSERT_TRUE(cache.find("c", &guess));
+    ASSERT_TRUE(cache.find("d", &guess));
+}
+
+TEST(GuessCache, sharedBetweenThreads) {
+    vector<string> answers = sampleAnswers(8, 50, 5);
+    NerdleSolver plain(8, GuessStrategy::Search);
+    const vector<size_t> expected =
+        runHeadlessBenchmark(&plain, answers).guessCounts_;
+    auto cache = make_shared<GuessCache>(1000);
+    vector<thread> threads;
+    vector<vector<size_t>> counts(4);
+    for (size_t t = 0; t < counts.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            NerdleSolver solver(8, GuessStrategy::Search);
+            solver.useCache(cache);
+            counts[t] = runHeadlessBenchmark(&solver, answers).guessCounts_;
+        });
+    }
+    for (thread& t : threads)
+        t.join();
+    for (const vector<size_t>& c : counts)
+        ASSERT_EQ(c, expected);
+    // every thread after the first one plays known games
+    ASSERT_GT(cache->hits(), cache->misses());
+    ASSERT_LE(cache->size(), cache->capacity());
+}
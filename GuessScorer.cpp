@@ -0,0 +1,255 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <string>
+#include <vector>
+#include "./GuessScorer.h"
+#include "./FeedbackPattern.h"
+#include "./PackedEquation.h"
+
+GuessScorer::GuessScorer(const int length, WorkStealingPool* pool)
+        : length_(length), pool_(pool) {
+    buckets_.resize(pool_->threads());
+    patterns_.resize(pool_->threads());
+    innerBuckets_.resize(pool_->threads());
+    innerPatterns_.resize(pool_->threads());
+    possible_.resize(pool_->threads());
+}
+
+vector<double> GuessScorer::entropies(const vector<string>& guesses,
+        const vector<string>& answers) {
+    PackedEquations packed(length_);
+    packed.reserve(answers.size());
+    for (const string& a : answers)
+        packed.add(a);
+    vector<double> result(guesses.size());
+    pool_->run(guesses.size(), [&](size_t i, unsigned int worker) {
+        result[i] = entropy(guesses[i], packed, worker);
+    });
+    return result;
+}
+
+size_t GuessScorer::bestByEntropy(const vector<string>& guesses,
+        const vector<string>& answers) {
+    vector<double> scores = entropies(guesses, answers);
+    size_t best = 0;
+    for (size_t i = 1; i < scores.size(); ++i) {
+        if (scores[i] > scores[best])
+            best = i;
+    }
+    return best;
+}
+
+size_t GuessScorer::bestByWorstCase(const vector<string>& guesses,
+        const vector<string>& answers, const int depth) {
+    PackedEquations packed(length_);
+    packed.reserve(answers.size());
+    for (const string& a : answers)
+        packed.add(a);
+    vector<uint64_t> result(guesses.size());
+    // the bound only ever sinks and a guess is only cut if it is worse than a
+    // guess seen before, so the result doesnt depend on the order
+    atomic<uint32_t> best(UINT32_MAX);
+    pool_->run(guesses.size(), [&](size_t i, unsigned int worker) {
+        result[i] = worstCase(guesses[i], answers, packed, depth, best,
+            worker);
+        const uint32_t worst = result[i] >> 32;
+        uint32_t b = best;
+        while (worst < b && !best.compare_exchange_weak(b, worst)) {}
+    });
+    size_t winner = 0;
+    for (size_t i = 1; i < result.size(); ++i) {
+        if (result[i] < result[winner])
+            winner = i;
+    }
+    return winner;
+}
+
+vector<double> GuessScorer::expectedTurns(const vector<string>& guesses,
+        const vector<string>& answers, const size_t rollouts,
+        const RandomStream& random) {
+    PackedEquations packed(length_);
+    packed.reserve(answers.size());
+    for (const string& a : answers)
+        packed.add(a);
+    vector<double> result(guesses.size());
+    pool_->run(guesses.size(), [&](size_t i, unsigned int worker) {
+        const uint64_t turns = simulate(guesses[i], answers, packed, rollouts,
+            random.fork(packEquation(guesses[i])), worker);
+        result[i] = rollouts == 0 ? 0 : static_cast<double>(turns) / rollouts;
+    });
+    return result;
+}
+
+size_t GuessScorer::bestByRollouts(const vector<string>& guesses,
+        const vector<string>& answers, const size_t rollouts,
+        const RandomStream& random) {
+    vector<double> turns = expectedTurns(guesses, answers, rollouts, random);
+    size_t best = 0;
+    for (size_t i = 1; i < turns.size(); ++i) {
+        if (turns[i] < turns[best])
+            best = i;
+    }
+    return best;
+}
+
+double GuessScorer::entropy(const string& guess,
+        const PackedEquations& answers, const unsigned int worker) {
+    vector<uint32_t>& buckets = buckets_[worker];
+    vector<uint32_t>& patterns = patterns_[worker];
+    if (buckets.empty())
+        buckets.resize(patternCount(length_), 0);
+    patterns.resize(answers.size());
+    feedbackPatterns(guess, answers, patterns.data());
+    for (const uint32_t p : patterns)
+        ++buckets[p];
+    // H = log(n) - sum(c * log(c)) / n over all buckets with c answers
+    double sum = 0;
+    for (const uint32_t p : patterns) {
+        uint32_t& c = buckets[p];
+        if (c == 0)
+            continue;
+        sum += c * log2(static_cast<double>(c));
+        c = 0;
+    }
+    const double n = answers.size();
+    return n == 0 ? 0 : log2(n) - sum / n;
+}
+
+vector<string> spreadSample(const vector<string>& eqs, const size_t size) {
+    if (eqs.size() <= size)
+        return eqs;
+    vector<string> result;
+    result.reserve(size);
+    for (size_t i = 0; i < size; ++i)
+        result.push_back(eqs[i * eqs.size() / size]);
+    return result;
+}
+
+uint64_t GuessScorer::worstCase(const string& guess,
+        const vector<string>& answers, const PackedEquations& packed,
+        const int depth, const uint32_t bound, const unsigned int worker) {
+    vector<uint32_t>& buckets = buckets_[worker];
+    vector<uint32_t>& patterns = patterns_[worker];
+    if (buckets.empty())
+        buckets.resize(patternCount(length_), 0);
+    uint32_t distinct;
+    const uint32_t largest = largestBucket(guess, packed,
+        depth == 1 ? bound : UINT32_MAX, &buckets, &patterns, &distinct);
+    // guesses with the same worst case are ranked by the amount of buckets
+    auto score = [&](uint64_t worst) {
+        return worst << 32 | (answers.size() - distinct);
+    };
+    if (depth == 1 || largest <= 1)
+        return score(largest);
+
+    // answers of every bucket with more than one answer, largest first
+    vector<uint32_t> order(answers.size());
+    for (uint32_t a = 0; a < order.size(); ++a)
+        order[a] = a;
+    sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return patterns[a] != patterns[b] ? patterns[a] < patterns[b] : a < b;
+    });
+    vector<pair<size_t, size_t>> groups;
+    for (size_t begin = 0, end; begin < order.size(); begin = end) {
+        for (end = begin + 1; end < order.size() &&
+                patterns[order[end]] == patterns[order[begin]]; ++end) {}
+        if (end - begin > 1)
+            groups.emplace_back(begin, end);
+    }
+    stable_sort(groups.begin(), groups.end(), [](auto a, auto b) {
+        return a.second - a.first > b.second - b.first;
+    });
+
+    vector<uint32_t>& innerBuckets = innerBuckets_[worker];
+    if (innerBuckets.empty())
+        innerBuckets.resize(patternCount(length_), 0);
+    uint32_t value = 1;
+    for (const auto& [begin, end] : groups) {
+        // the follow-up guess cant leave more than the bucket has
+        if (end - begin <= value)
+            break;
+        PackedEquations bucket(length_);
+        bucket.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i)
+            bucket.add(answers[order[i]]);
+        uint32_t inner = end - begin;
+        for (size_t i = begin; i < end && i - begin < innerProbes_; ++i) {
+            inner = min(inner, largestBucket(answers[order[i]], bucket,
+                inner - 1, &innerBuckets, &innerPatterns_[worker], nullptr));
+            if (inner == 1)
+                break;
+        }
+        value = max(value, inner);
+        // beta cutoff: this guess is already worse than the best one
+        if (value > bound)
+            return score(value);
+    }
+    return score(value);
+}
+
+uint64_t GuessScorer::simulate(const string& guess,
+        const vector<string>& answers, const PackedEquations& packed,
+        const size_t rollouts, RandomStream random,
+        const unsigned int worker) {
+    if (answers.empty())
+        return 0;
+    vector<uint32_t>& patterns = patterns_[worker];
+    vector<uint32_t>& possible = possible_[worker];
+    patterns.resize(answers.size());
+    feedbackPatterns(guess, packed, patterns.data());
+    uint64_t turns = 0;
+    for (size_t r = 0; r < rollouts; ++r) {
+        const uint32_t answer = random.below(answers.size());
+        ++turns;
+        if (isWinPattern(patterns[answer], length_))
+            continue;
+        possible.clear();
+        for (uint32_t a = 0; a < answers.size(); ++a) {
+            if (patterns[a] == patterns[answer])
+                possible.push_back(a);
+        }
+        // every wrong guess rules out at least itself, so the game ends
+        while (true) {
+            const uint32_t pick = possible[random.below(possible.size())];
+            ++turns;
+            if (pick == answer)
+                break;
+            const string& g = answers[pick];
+            const int hint = feedbackPattern(g, answers[answer]);
+            size_t kept = 0;
+            for (const uint32_t a : possible) {
+                if (feedbackPattern(g, answers[a]) == hint)
+                    possible[kept++] = a;
+            }
+            possible.resize(kept);
+        }
+    }
+    return turns;
+}
+
+uint32_t GuessScorer::largestBucket(const string& guess,
+        const PackedEquations& answers, const uint32_t bound,
+        vector<uint32_t>* buckets, vector<uint32_t>* patterns,
+        uint32_t* distinct) const {
+    patterns->resize(answers.size());
+    feedbackPatterns(guess, answers, patterns->data());
+    uint32_t largest = 0;
+    uint32_t used = 0;
+    size_t counted = 0;
+    while (counted < patterns->size() && largest <= bound) {
+        const uint32_t c = ++(*buckets)[(*patterns)[counted++]];
+        largest = max(largest, c);
+        used += c == 1;
+    }
+    for (size_t i = 0; i < counted; ++i)
+        (*buckets)[(*patterns)[i]] = 0;
+    if (distinct)
+        *distinct = used;
+    return largest;
+}
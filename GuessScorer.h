@@ -0,0 +1,96 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef GUESSSCORER_H_
+#define GUESSSCORER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "./FeedbackKernel.h"
+#include "./RandomStream.h"
+#include "./WorkStealingPool.h"
+
+using namespace std;  // NOLINT
+
+// rates guesses by how they split a set of possible answers into the
+// feedback patterns nerdle would show
+class GuessScorer {
+ public:
+    // setup scorer for equations of given length that runs on pool
+    GuessScorer(const int length, WorkStealingPool* pool);
+    // returns the expected information (in bits) the pattern of every guess
+    // gives if every answer is equally likely
+    vector<double> entropies(const vector<string>& guesses,
+        const vector<string>& answers);
+    // returns the index of the guess with the highest entropy, on ties the
+    // lowest index wins
+    size_t bestByEntropy(const vector<string>& guesses,
+        const vector<string>& answers);
+    // returns the index of the guess that leaves the fewest answers in the
+    // worst case, on ties the one with more patterns and then the lowest
+    // index wins
+    // with depth 1 a guess is rated by its largest pattern bucket, with
+    // depth 2 every bucket counts with the best follow-up guess out of the
+    // bucket, guesses that cant beat the best one so far are abandoned as
+    // soon as one of their buckets is worse
+    size_t bestByWorstCase(const vector<string>& guesses,
+        const vector<string>& answers, const int depth);
+    // returns the average amount of guesses (the first one included) of
+    // rollouts simulated games per guess: every game draws its answer from
+    // answers, starts with the guess and goes on with random answers that are
+    // still possible until it is won
+    // every guess draws its numbers from a fork of random for the packed
+    // guess, so its result only depends on random and the guess itself and
+    // neither on the other guesses nor on the threads
+    vector<double> expectedTurns(const vector<string>& guesses,
+        const vector<string>& answers, const size_t rollouts,
+        const RandomStream& random);
+    // returns the index of the guess with the fewest expected turns, on ties
+    // the lowest index wins
+    size_t bestByRollouts(const vector<string>& guesses,
+        const vector<string>& answers, const size_t rollouts,
+        const RandomStream& random);
+
+ private:
+    int length_;
+    WorkStealingPool* pool_;
+    // per thread: amount of answers per pattern and pattern of every answer
+    vector<vector<uint32_t>> buckets_;
+    vector<vector<uint32_t>> patterns_;
+
+    // per thread: buckets and patterns of the follow-up guesses
+    vector<vector<uint32_t>> innerBuckets_;
+    vector<vector<uint32_t>> innerPatterns_;
+    // follow-up guesses tried per bucket with depth 2
+    static constexpr size_t innerProbes_ = 50;
+    // per thread: answers still possible in a simulated game
+    vector<vector<uint32_t>> possible_;
+
+    // entropy of one guess computed with the scratch memory of worker
+    double entropy(const string& guess, const PackedEquations& answers,
+        const unsigned int worker);
+    // worst case of one guess (upper 32 bits) and the amount of answers
+    // minus the amount of patterns (lower 32 bits), computed with the scratch
+    // memory of worker, the search stops as soon as the worst case is
+    // known to be more than bound
+    uint64_t worstCase(const string& guess, const vector<string>& answers,
+        const PackedEquations& packed, const int depth, const uint32_t bound,
+        const unsigned int worker);
+    // total guesses of rollouts simulated games that start with guess
+    uint64_t simulate(const string& guess, const vector<string>& answers,
+        const PackedEquations& packed, const size_t rollouts,
+        RandomStream random, const unsigned int worker);
+    // returns the largest bucket guess splits answers into or something
+    // above bound if that is more than bound, writes the amount of buckets
+    // to distinct (if not null)
+    uint32_t largestBucket(const string& guess,
+        const PackedEquations& answers, const uint32_t bound,
+        vector<uint32_t>* buckets, vector<uint32_t>* patterns,
+        uint32_t* distinct) const;
+};
+
+// returns up to size equations evenly spread over eqs
+vector<string> spreadSample(const vector<string>& eqs, const size_t size);
+
+#endif  // GUESSSCORER_H_
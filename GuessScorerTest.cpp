@@ -0,0 +1,65 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "./EquationUniverse.h"
+#include "./GuessScorer.h"
+
+TEST(GuessScorer, bestByEntropy) {
+    WorkStealingPool pool(2);
+    GuessScorer scorer(8, &pool);
+    const vector<string> answers = {"12+35=47", "12+36=48", "12+37=49"};
+    // the last guess tells all answers apart, the first one none of them
+    const vector<string> guesses = {"10+30=40", "12+35=49"};
+    vector<double> h = scorer.entropies(guesses, answers);
+    ASSERT_DOUBLE_EQ(h[0], 0);
+    ASSERT_DOUBLE_EQ(h[1], log2(3));
+    ASSERT_EQ(scorer.bestByEntropy(guesses, answers), 1u);
+}
+
+TEST(GuessScorer, bestByWorstCase) {
+    // a guess that tells every answer apart wins, ties go to the first one
+    WorkStealingPool pool(3);
+    GuessScorer scorer(8, &pool);
+    const vector<string> few = {"12+35=47", "12+36=48", "12+37=49"};
+    ASSERT_EQ(scorer.bestByWorstCase({"10+30=40", "12+35=49"}, few, 1), 1u);
+    ASSERT_EQ(scorer.bestByWorstCase({"12+35=47", "12+36=48"}, few, 2), 0u);
+
+    // the cutoffs dont make the result depend on the threads
+    const vector<string>& all = EquationUniverse::get(8)->equations();
+    const vector<string> answers = spreadSample(all, 300);
+    const vector<string> guesses = spreadSample(all, 60);
+    WorkStealingPool single(1);
+    GuessScorer reference(8, &single);
+    for (int depth : {1, 2}) {
+        ASSERT_EQ(scorer.bestByWorstCase(guesses, answers, depth),
+            reference.bestByWorstCase(guesses, answers, depth));
+    }
+}
+
+TEST(GuessScorer, expectedTurns) {
+    WorkStealingPool pool(3);
+    GuessScorer scorer(8, &pool);
+    const vector<string> few = {"12+35=47", "12+36=48", "12+37=49"};
+    // after the second guess the answer is known, so every game ends with
+    // its second guess, without it the random guesses need 11 / 6 more on
+    // average
+    vector<double> turns = scorer.expectedTurns({"10+30=40", "12+35=49"}, few,
+        300, RandomStream(7));
+    ASSERT_NEAR(turns[0], 1 + 11.0 / 6, 0.15);
+    ASSERT_DOUBLE_EQ(turns[1], 2);
+    ASSERT_EQ(scorer.bestByRollouts({"10+30=40", "12+35=49"}, few, 300,
+        RandomStream(7)), 1u);
+
+    // every guess has its own stream, so the threads dont matter
+    const vector<string>& all = EquationUniverse::get(8)->equations();
+    const vector<string> answers = spreadSample(all, 500);
+    const vector<string> guesses = spreadSample(all, 40);
+    WorkStealingPool single(1);
+    GuessScorer reference(8, &single);
+    ASSERT_EQ(scorer.expectedTurns(guesses, answers, 20, RandomStream(3)),
+        reference.expectedTurns(guesses, answers, 20, RandomStream(3)));
+}
@@ -0,0 +1,109 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "./HeadlessBenchmark.h"
+#include "./EquationUniverse.h"
+#include "./EquationValidator.h"
+#include "./FeedbackPattern.h"
+
+uint64_t BenchmarkResult::latencyPercentile(const double p) const {
+    if (latencies_.empty())
+        return 0;
+    vector<uint64_t> sorted = latencies_;
+    size_t index = p * (sorted.size() - 1);
+    nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+double BenchmarkResult::averageGuesses() const {
+    size_t won = 0;
+    size_t guesses = 0;
+    for (size_t n = 0; n < guessCounts_.size(); ++n) {
+        won += guessCounts_[n];
+        guesses += n * guessCounts_[n];
+    }
+    return won == 0 ? 0 : static_cast<double>(guesses) / won;
+}
+
+size_t BenchmarkResult::maxGuesses() const {
+    for (size_t n = guessCounts_.size(); n-- > 0;) {
+        if (guessCounts_[n] > 0)
+            return n;
+    }
+    return 0;
+}
+
+string BenchmarkResult::toJson() const {
+    ostringstream out;
+    out << "{\"length\": " << length_ << ", \"games\": " << games_
+        << ", \"failures\": " << failures_ << ", \"guesses\": {";
+    bool first = true;
+    for (size_t n = 0; n < guessCounts_.size(); ++n) {
+        if (guessCounts_[n] == 0)
+            continue;
+        out << (first ? "" : ", ") << "\"" << n << "\": " << guessCounts_[n];
+        first = false;
+    }
+    out << "}, \"averageGuesses\": " << averageGuesses()
+        << ", \"maxGuesses\": " << maxGuesses()
+        << ", \"seconds\": " << seconds_
+        << ", \"latencyNs\": {\"p50\": " << latencyPercentile(0.5)
+        << ", \"p99\": " << latencyPercentile(0.99)
+        << ", \"max\": " << latencyPercentile(1) << "}}";
+    return out.str();
+}
+
+NerdleStatusRow hintRow(const string& guess, const string& answer) {
+    return patternRow(guess, feedbackPattern(guess, answer));
+}
+
+vector<string> sampleAnswers(const int length, const size_t count,
+        const unsigned int seed) {
+    shared_ptr<const EquationUniverse> all = EquationUniverse::get(length);
+    mt19937 random(seed);
+    uniform_int_distribution<size_t> pick(0, all->size() - 1);
+    vector<string> answers;
+    for (size_t i = 0; i < count; ++i)
+        answers.push_back(all->equation(pick(random)));
+    return answers;
+}
+
+BenchmarkResult runHeadlessBenchmark(NerdleSolverBase* solver,
+        const vector<string>& answers, const int maxGuesses) {
+    BenchmarkResult result;
+    result.length_ = answers.empty() ? 0 : answers.front().size();
+    result.guessCounts_.resize(maxGuesses + 1, 0);
+    auto start = chrono::steady_clock::now();
+    for (const string& answer : answers) {
+        ++result.games_;
+        NerdleGameState state;
+        bool won = false;
+        for (int turn = 1; turn <= maxGuesses; ++turn) {
+            auto before = chrono::steady_clock::now();
+            string guess = solver->nextGuess(state);
+            result.latencies_.push_back(chrono::duration_cast<
+                chrono::nanoseconds>(chrono::steady_clock::now() - before)
+                .count());
+            if (!isValidEquation(guess, answer.size()))
+                break;
+            state.push_back(hintRow(guess, answer));
+            if (guess == answer) {
+                ++result.guessCounts_[turn];
+                won = true;
+                break;
+            }
+        }
+        if (!won)
+            ++result.failures_;
+    }
+    result.seconds_ = chrono::duration<double>(
+        chrono::steady_clock::now() - start).count();
+    return result;
+}
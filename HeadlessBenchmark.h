@@ -0,0 +1,52 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef HEADLESSBENCHMARK_H_
+#define HEADLESSBENCHMARK_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "./NerdleBenchmark.h"
+
+using namespace std;  // NOLINT
+
+// outcome of playing a set of games with one solver
+struct BenchmarkResult {
+    int length_ = 0;
+    size_t games_ = 0;
+    // games that werent won within the allowed guesses or got an invalid
+    // guess
+    size_t failures_ = 0;
+    // guessCounts_[n] is the amount of won games that needed n guesses
+    vector<size_t> guessCounts_;
+    // duration of every nextGuess call in nanoseconds
+    vector<uint64_t> latencies_;
+    // duration of all games in seconds
+    double seconds_ = 0;
+
+    // returns the latency (in nanoseconds) that the fraction p of all calls
+    // didnt exceed, e.g. p = 0.99 for the 99th percentile
+    uint64_t latencyPercentile(const double p) const;
+    // average guesses of the won games
+    double averageGuesses() const;
+    // maximum guesses of the won games
+    size_t maxGuesses() const;
+    // returns the result as one line of json
+    string toJson() const;
+};
+
+// returns the hints nerdle shows for guess if answer is the solution
+NerdleStatusRow hintRow(const string& guess, const string& answer);
+
+// returns count answers of given length drawn uniformly from all valid
+// equations, the same seed always gives the same answers
+vector<string> sampleAnswers(const int length, const size_t count,
+    const unsigned int seed);
+
+// plays one game against every answer without any terminal output
+// a game fails if it isnt won after maxGuesses guesses
+BenchmarkResult runHeadlessBenchmark(NerdleSolverBase* solver,
+    const vector<string>& answers, const int maxGuesses = 6);
+
+#endif  // HEADLESSBENCHMARK_H_
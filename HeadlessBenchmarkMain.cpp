@@ -0,0 +1,45 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "./HeadlessBenchmark.h"
+#include "./NerdleSolver.h"
+
+// plays sampled games without a terminal and prints the result as json
+int main(int argc, char** argv) {
+    const auto usage = []() {
+        std::cerr << "Usage ./HeadlessBenchmarkMain <lengthOfExpressions> "
+            << "[random|universe|search|entropy|minimax|montecarlo] "
+            << "[games] [seed] [cacheSize]"
+            << std::endl;
+        std::exit(1);
+    };
+    if (argc < 2 || argc > 6)
+        usage();
+    const int length = std::atoi(argv[1]);
+    if (!isSupportedLength(length)) {
+        std::cerr << "Unsupported length " << argv[1] << std::endl;
+        std::exit(1);
+    }
+    GuessStrategy strategy = GuessStrategy::Universe;
+    if (argc >= 3 && !parseStrategy(argv[2], &strategy))
+        usage();
+    const size_t games = argc >= 4 ? std::atoi(argv[3]) : 1000;
+    const unsigned int seed = argc >= 5 ? std::atoi(argv[4]) : 1;
+    const size_t cacheSize = argc == 6 ? std::atoi(argv[5]) : 0;
+
+    // the seed picks the answers and the random choices of the solver
+    NerdleSolver solver(length, strategy);
+    solver.seed(seed);
+    auto cache = cacheSize > 0 ? std::make_shared<GuessCache>(cacheSize)
+        : nullptr;
+    solver.useCache(cache);
+    BenchmarkResult result = runHeadlessBenchmark(&solver,
+        sampleAnswers(length, games, seed));
+    std::cout << result.toJson() << std::endl;
+    std::cout << solver.counters().toJson() << std::endl;
+    if (cache)
+        std::cout << cache->toJson() << std::endl;
+}
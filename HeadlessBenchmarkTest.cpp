@@ -0,0 +1,51 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "./HeadlessBenchmark.h"
+#include "./NerdleSolver.h"
+
+// solver that plays a fixed list of guesses in every game
+class ScriptedSolver : public NerdleSolverBase {
+ public:
+    explicit ScriptedSolver(const vector<string>& guesses)
+        : guesses_(guesses) {}
+    string nextGuess(const NerdleGameState& gameState) override {
+        return guesses_.at(gameState.size() % guesses_.size());
+    }
+
+ private:
+    vector<string> guesses_;
+};
+
+TEST(HeadlessBenchmark, runHeadlessBenchmark) {
+    ScriptedSolver scripted({"1+7*9=64", "12+35=47", "45+45=90"});
+    BenchmarkResult result = runHeadlessBenchmark(&scripted,
+        {"12+35=47", "45+45=90", "1+7*9=64", "9*8-6=66"}, 3);
+    ASSERT_EQ(result.games_, 4u);
+    ASSERT_EQ(result.failures_, 1u);
+    ASSERT_EQ(result.guessCounts_[1], 1u);
+    ASSERT_EQ(result.guessCounts_[2], 1u);
+    ASSERT_EQ(result.guessCounts_[3], 1u);
+    ASSERT_EQ(result.maxGuesses(), 3u);
+    ASSERT_EQ(result.averageGuesses(), 2);
+    ASSERT_EQ(result.latencies_.size(), 3u + 2 + 1 + 3);
+    ASSERT_LE(result.latencyPercentile(0.5), result.latencyPercentile(1));
+    ASSERT_NE(result.toJson().find("\"failures\": 1"), string::npos);
+
+    // invalid guesses fail the game
+    ScriptedSolver invalid({"1+1=3+0="});
+    ASSERT_EQ(runHeadlessBenchmark(&invalid, {"12+35=47"}).failures_, 1u);
+}
+
+TEST(HeadlessBenchmark, sampleAnswers) {
+    vector<string> answers = sampleAnswers(8, 50, 7);
+    ASSERT_EQ(answers, sampleAnswers(8, 50, 7));
+    ASSERT_NE(answers, sampleAnswers(8, 50, 8));
+    NerdleSolver solver(8);
+    BenchmarkResult result = runHeadlessBenchmark(&solver, answers, 10);
+    ASSERT_EQ(result.failures_, 0u);
+    ASSERT_EQ(result.length_, 8);
+}
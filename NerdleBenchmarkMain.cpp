@@ -5,6 +5,8 @@
 // and Johannes Kalmbach for the C++-course at the University of Freiburg.
 
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <vector>
@@ -12,27 +14,78 @@
 // Implementation of your custom solver.
 #include "./NerdleSolver.h"
 
+// passes every call on to solver and counts games and guesses
+class GuessCounter : public NerdleSolverBase {
+ public:
+    explicit GuessCounter(NerdleSolverBase* solver) : solver_(solver) {}
+    string nextGuess(const NerdleGameState& gameState) override {
+        if (gameState.empty())
+            ++games_;
+        ++guesses_;
+        maxGuesses_ = std::max(maxGuesses_, gameState.size() + 1);
+        return solver_->nextGuess(gameState);
+    }
+    size_t games() const { return games_; }
+    size_t guesses() const { return guesses_; }
+    // most guesses of one game
+    size_t maxGuesses() const { return maxGuesses_; }
+
+ private:
+    NerdleSolverBase* solver_;
+    size_t games_ = 0;
+    size_t guesses_ = 0;
+    size_t maxGuesses_ = 0;
+};
+
 int main(int argc, char** argv) {
     // Read the command lines from file. The first argument should always
     // be the expression length (8, 9, 10, 11). If your solver requires
     // additional arguments, they should be in argv[2], argv[3] etc.
     // Don't forget to update the Usage information below so that your
     // tutor knows, how to run your code.
-    if (argc != 2) {
-    std::cerr << "Usage ./ExpressionGeneratorMain <lengthOfExpressions>"
-        << std::endl;
-    std::exit(1);
-    }
+    const auto usage = []() {
+        std::cerr << "Usage ./NerdleBenchmarkMain <lengthOfExpressions> "
+            << "[random|universe|search|entropy|minimax|montecarlo] "
+            << "[openingBookFile]" << std::endl;
+        std::exit(1);
+    };
+    if (argc < 2 || argc > 4)
+        usage();
 
     int lengthOfExpressions = std::atoi(argv[1]);
+    if (!isSupportedLength(lengthOfExpressions)) {
+        std::cerr << "Unsupported length " << argv[1] << std::endl;
+        std::exit(1);
+    }
+    GuessStrategy strategy = GuessStrategy::Universe;
+    if (argc >= 3 && !parseStrategy(argv[2], &strategy))
+        usage();
 
     // Create an Object of your solver class. This might take some arguments
     // (the lengths of the expressions, additional data passed in from the
     // command line, etc.
-    NerdleSolver solver(lengthOfExpressions);
+    NerdleSolver solver(lengthOfExpressions, strategy);
+    if (argc == 4) {
+        auto book = std::make_shared<OpeningBook>();
+        if (!book->load(argv[3]) || !solver.useOpeningBook(book)) {
+            std::cerr << "Cannot read opening book " << argv[3] << std::endl;
+            std::exit(1);
+        }
+    }
+    GuessCounter counter(&solver);
 
     // Run all benchmarks.
-    runNerdleBenchmark(&solver, lengthOfExpressions);
+    auto start = std::chrono::steady_clock::now();
+    runNerdleBenchmark(&counter, lengthOfExpressions);
+    std::chrono::duration<double> time =
+        std::chrono::steady_clock::now() - start;
+    std::cout << "Wall time: " << time.count() << "s" << std::endl;
+    if (counter.games() > 0) {
+        std::cout << "Average guesses: " << static_cast<double>(
+            counter.guesses()) / counter.games() << std::endl;
+        std::cout << "Max guesses: " << counter.maxGuesses() << std::endl;
+    }
+    std::cout << "Counters: " << solver.counters().toJson() << std::endl;
 
     // Alternatively for debugging you can run the benchmark with specified
     // expressions:
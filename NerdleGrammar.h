@@ -0,0 +1,85 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef NERDLEGRAMMAR_H_
+#define NERDLEGRAMMAR_H_
+
+#include <array>
+#include <cstdint>
+#include "./NerdleSymbols.h"
+
+// states of the automaton that reads a nerdle equation symbol by symbol
+// Operand: an lhs number has to start (at the beginning and after operators)
+// Zero: the current lhs number is a single 0
+// Number: inside of an lhs number that can get more digits
+// Result, ResultZero, ResultNumber: the same for the rhs after '='
+// Dead: the symbols so far cant be the start of an equation
+// an equation has correct syntax if it ends in ResultZero or ResultNumber
+enum class GrammarState : uint8_t {
+    Operand, Zero, Number, Result, ResultZero, ResultNumber, Dead
+};
+constexpr int kGrammarStates = 7;
+
+// next state for every state and symbol index
+constexpr std::array<std::array<GrammarState, kSymbols>, kGrammarStates>
+        grammarTable() {
+    using G = GrammarState;
+    std::array<std::array<G, kSymbols>, kGrammarStates> table = {};
+    for (int s = 0; s < kGrammarStates; ++s) {
+        for (int c = 0; c < kSymbols; ++c)
+            table[s][c] = G::Dead;
+    }
+    const int ops[] = {symbolIndex('+'), symbolIndex('-'), symbolIndex('*'),
+        symbolIndex('/')};
+    const int equals = symbolIndex('=');
+    // numbers dont have leading zeros
+    table[int(G::Operand)][0] = G::Zero;
+    table[int(G::Result)][0] = G::ResultZero;
+    for (int d = 1; d <= 9; ++d) {
+        table[int(G::Operand)][d] = G::Number;
+        table[int(G::Result)][d] = G::ResultNumber;
+    }
+    for (int d = 0; d <= 9; ++d) {
+        table[int(G::Number)][d] = G::Number;
+        table[int(G::ResultNumber)][d] = G::ResultNumber;
+    }
+    // every lhs number can be followed by a single operator or the only '='
+    for (G s : {G::Zero, G::Number}) {
+        for (int op : ops)
+            table[int(s)][op] = G::Operand;
+        table[int(s)][equals] = G::Result;
+    }
+    return table;
+}
+constexpr auto kGrammarTable = grammarTable();
+
+// returns the state after reading c in state s
+constexpr GrammarState grammarStep(const GrammarState s, const char c) {
+    const int index = symbolIndex(c);
+    return index < 0 ? GrammarState::Dead : kGrammarTable[int(s)][index];
+}
+
+// symbols that dont lead from a state into Dead
+constexpr std::array<SymbolMask, kGrammarStates> grammarMasks() {
+    std::array<SymbolMask, kGrammarStates> masks = {};
+    for (int s = 0; s < kGrammarStates; ++s) {
+        for (int c = 0; c < kSymbols; ++c) {
+            if (kGrammarTable[s][c] != GrammarState::Dead)
+                masks[s] |= 1u << c;
+        }
+    }
+    return masks;
+}
+constexpr auto kGrammarMasks = grammarMasks();
+
+// returns the symbols that can follow in state s
+constexpr SymbolMask grammarMask(const GrammarState s) {
+    return kGrammarMasks[int(s)];
+}
+
+// returns true if an equation can end in state s
+constexpr bool isAccepting(const GrammarState s) {
+    return s == GrammarState::ResultZero || s == GrammarState::ResultNumber;
+}
+
+#endif  // NERDLEGRAMMAR_H_
@@ -0,0 +1,44 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <gtest/gtest.h>
+#include <string>
+#include "./NerdleGrammar.h"
+
+using namespace std;  // NOLINT
+
+// returns the state after reading all of eq
+GrammarState readAll(const string& eq) {
+    GrammarState s = GrammarState::Operand;
+    for (const char c : eq)
+        s = grammarStep(s, c);
+    return s;
+}
+
+TEST(NerdleGrammar, grammarStep) {
+    ASSERT_TRUE(isAccepting(readAll("12+35=47")));
+    ASSERT_TRUE(isAccepting(readAll("0+0=0")));
+    ASSERT_TRUE(isAccepting(readAll("10-10=0")));
+    // the grammar only checks the syntax
+    ASSERT_TRUE(isAccepting(readAll("1=2")));
+    ASSERT_EQ(readAll("12+35"), GrammarState::Number);
+    ASSERT_EQ(readAll("12+"), GrammarState::Operand);
+    ASSERT_EQ(readAll("12+35="), GrammarState::Result);
+    ASSERT_EQ(readAll("05"), GrammarState::Dead);
+    ASSERT_EQ(readAll("+1"), GrammarState::Dead);
+    ASSERT_EQ(readAll("1+*2"), GrammarState::Dead);
+    ASSERT_EQ(readAll("1+1=2=2"), GrammarState::Dead);
+    ASSERT_EQ(readAll("1+1=2+0"), GrammarState::Dead);
+    ASSERT_EQ(readAll("1+1=02"), GrammarState::Dead);
+    ASSERT_EQ(readAll("1+a"), GrammarState::Dead);
+}
+
+TEST(NerdleGrammar, grammarMask) {
+    static_assert(grammarMask(GrammarState::Operand) == kNumMask, "");
+    static_assert(grammarMask(GrammarState::Zero) ==
+        (kOpMask | kEqualsMask), "");
+    static_assert(grammarMask(GrammarState::Number) == kAllMask, "");
+    static_assert(grammarMask(GrammarState::ResultNumber) == kNumMask, "");
+    static_assert(grammarMask(GrammarState::ResultZero) == 0, "");
+    static_assert(grammarMask(GrammarState::Dead) == 0, "");
+}
@@ -1,6 +1,7 @@
 // Copyright 2022, Henry Herröder
 // Author: Henry Herröder
 
+#include <chrono>
 #include <memory>
 #include <vector>
 #include <string>
@@ -8,35 +9,213 @@
 #include "./NerdleSolver.h"
 
 std::string NerdleSolver::nextGuess(const NerdleGameState& gameState) {
-    if (gameState.size() < lastGSSize_) {
-        board_ = Board(length_);
+    return nextGuess(gameState, &game_, scorer());
+}
+
+string NerdleSolver::nextGuess(const NerdleGameState& gameState,
+        const Deadline deadline, bool* finished) {
+    return nextGuess(gameState, &game_, scorer(), deadline, finished);
+}
+
+string NerdleSolver::nextGuess(const NerdleGameState& gameState,
+        GameContext* game, GuessScorer* scorer, const Deadline deadline,
+        bool* finished) const {
+    bool done = true;
+    if (!finished)
+        finished = &done;
+    *finished = true;
+    Board& board = game->board_;
+    game->counters_.add(board.takeCounters());
+    if (gameState.size() < game->lastGSSize_) {
+        restart(game);
     }
     if (gameState.size() > 0) {
         if (checkWin(gameState.back()))
-            board_ = Board(length_);
+            restart(game);
         else
-            board_.update(gameState.back());
+            board.update(gameState.back());
+    }
+    // as long as the game follows the opening book nothing has to be searched
+    const OpeningBook* book = engine_->book().get();
+    string guess = book ? book->guess(gameState) : "";
+    if (!guess.empty()) {
+        game->lastGSSize_ = gameState.size();
+        return guess;
     }
-    else if (gameState.size() == 0) {
+    if (gameState.size() == 0) {
         // the first guess for every game should include a huge viarty of different
         // symbols (save computation time)
-        switch (length_) {
-            case 8:
-                return "1+7*9=64";
-            case 9:
-                return "20+7*9=83";
-            case 10:
-                return "1+7*9-0=64";
-            case 11:
-                return "21+7*9-0=84";
+        string opening = openingGuess(length_);
+        if (!opening.empty())
+            return opening;
+    }
+    // the guess only depends on the rows so far, which games repeat a lot
+    string key;
+    if (cache_) {
+        key = GuessCache::key(gameState);
+        if (cache_->find(key, &guess)) {
+            game->lastGSSize_ = gameState.size();
+            return guess;
         }
     }
-    string eq = board_.getEqCO();
-    string lastTry = board_.getEqAddWP(eq);
-    lastTry = board_.getEqGuessRest(lastTry);
-    while (!checkSyntax(lastTry) || !checkCorrectEquation(lastTry)) {
-        eq = board_.getEqCO();
-        lastTry = board_.getEqAddWP(eq);
+    if (strategy_ == GuessStrategy::Universe)
+        guess = guessFromUniverse(board);
+    else if (strategy_ == GuessStrategy::Random)
+        guess = guessRandom(&board, deadline);
+    else if (strategy_ == GuessStrategy::Entropy)
+        guess = guessByEntropy(board, scorer, deadline, finished);
+    else if (strategy_ == GuessStrategy::Minimax)
+        guess = guessByWorstCase(board, scorer, deadline, finished);
+    else if (strategy_ == GuessStrategy::MonteCarlo)
+        guess = guessByRollouts(board, scorer,
+            RandomStream(game->seed_, 1 + gameState.size()), deadline,
+            finished);
+    // random guessing only gives up early at the deadline
+    if (guess.empty() && strategy_ == GuessStrategy::Random &&
+            chrono::steady_clock::now() >= deadline)
+        *finished = false;
+    // the search is exhaustive, so if it finds nothing either the hints
+    // contradict each other and any valid equation will do
+    if (guess.empty())
+        guess = board.getEqSearch();
+    if (guess.empty())
+        guess = openingGuess(length_);
+    // a guess cut short by the deadline isnt what the cache promises
+    if (cache_ && *finished)
+        cache_->insert(key, guess);
+    game->lastGSSize_ = gameState.size();
+    return guess;
+}
+
+GameContext NerdleSolver::newGame() const {
+    GameContext game = engine_->start();
+    game.seed_ = game_.seed_;
+    game.board_.seed(game.seed_);
+    return game;
+}
+
+GameContext NerdleSolver::gameAt(const NerdleGameState& gameState) const {
+    GameContext game = newGame();
+    for (size_t r = 0; r + 1 < gameState.size(); ++r)
+        game.board_.update(gameState[r]);
+    game.lastGSSize_ = gameState.empty() ? 0 : gameState.size() - 1;
+    return game;
+}
+
+void NerdleSolver::seed(const uint64_t seed) {
+    game_.seed_ = seed;
+    game_.board_.seed(seed);
+}
+
+GuessScorer* NerdleSolver::scorer() {
+    // solvers driven through a BatchSolver never need one
+    if (!scorer_ && (strategy_ == GuessStrategy::Entropy ||
+            strategy_ == GuessStrategy::Minimax ||
+            strategy_ == GuessStrategy::MonteCarlo))
+        scorer_ = make_unique<GuessScorer>(length_, engine_->pool());
+    return scorer_.get();
+}
+
+void NerdleSolver::restart(GameContext* game) const {
+    // the counters cover all games played with one context
+    game->board_ = engine_->start().board_;
+    game->board_.seed(game->seed_);
+    game->lastGSSize_ = 0;
+}
+
+string NerdleSolver::guessFromUniverse(const Board& board) const {
+    // a guess that was tried already but isnt the answer would have given
+    // other hints, so every candidate is new
+    if (board.candidateCount() == 0)
+        return "";
+    return board.candidate(0);
+}
+
+vector<string> NerdleSolver::candidateSample(const Board& board,
+        const size_t size) const {
+    // the same equations as spreadSample, but only those are unpacked
+    const size_t count = board.candidateCount();
+    vector<string> sample;
+    sample.reserve(min(count, size));
+    for (size_t i = 0; i < min(count, size); ++i)
+        sample.push_back(board.candidate(count <= size ? i : i * count / size));
+    return sample;
+}
+
+vector<string> NerdleSolver::probes(const Board& board,
+        const size_t consistent, const size_t other) const {
+    // consistent equations come first so they win ties
+    vector<string> guesses = candidateSample(board, consistent);
+    const vector<PackedEquation>& all = engine_->universe()->packed();
+    for (size_t i = 0; i < all.size();
+            i += max<size_t>(1, all.size() / other)) {
+        if (!board.isConsistent(all[i]))
+            guesses.push_back(unpackEquation(all[i]));
+    }
+    return guesses;
+}
+
+string NerdleSolver::guessByEntropy(const Board& board,
+        GuessScorer* scorer, const Deadline deadline, bool* finished) const {
+    // with two candidates left guessing one of them is never worse
+    if (board.candidateCount() <= 2)
+        return board.candidateCount() == 0 ? "" : board.candidate(0);
+    vector<string> guesses = probes(board, entropyProbes_, entropyOtherProbes_);
+    vector<string> answers = candidateSample(board, entropyAnswers_);
+    return bestInChunks(guesses, deadline, finished,
+        [&](const vector<string>& chunk) {
+            return scorer->bestByEntropy(chunk, answers);
+        });
+}
+
+string NerdleSolver::guessByWorstCase(const Board& board,
+        GuessScorer* scorer, const Deadline deadline, bool* finished) const {
+    if (board.candidateCount() <= 2)
+        return board.candidateCount() == 0 ? "" : board.candidate(0);
+    vector<string> guesses = probes(board, minimaxProbes_, minimaxOtherProbes_);
+    vector<string> answers = candidateSample(board, minimaxAnswers_);
+    // looking one guess further ahead only pays off for few answers
+    const int depth = answers.size() <= minimaxDeepAnswers_ ? 2 : 1;
+    return bestInChunks(guesses, deadline, finished,
+        [&](const vector<string>& chunk) {
+            return scorer->bestByWorstCase(chunk, answers, depth);
+        });
+}
+
+string NerdleSolver::guessByRollouts(const Board& board, GuessScorer* scorer,
+        const RandomStream& random, const Deadline deadline,
+        bool* finished) const {
+    if (board.candidateCount() <= 2)
+        return board.candidateCount() == 0 ? "" : board.candidate(0);
+    vector<string> guesses = probes(board, rolloutProbes_, rolloutOtherProbes_);
+    vector<string> answers = candidateSample(board, rolloutAnswers_);
+    return bestInChunks(guesses, deadline, finished,
+        [&](const vector<string>& chunk) {
+            return scorer->bestByRollouts(chunk, answers, rollouts_, random);
+        });
+}
+
+string NerdleSolver::guessRandom(Board* board,
+        const Deadline deadline) const {
+    string eq = board->getEqCO();
+    string lastTry = board->getEqAddWP(eq);
+    lastTry = board->getEqGuessRest(lastTry);
+    // the rhs follows from the lhs, so guessing its digits would mostly fail
+    board->deriveRhs(&lastTry);
+    int retries = 0;
+    EquationError error;
+    while ((error = equationError(lastTry, length_)) != EquationError::None) {
+        if (error == EquationError::Syntax)
+            NERDLE_COUNT(board->counters()->syntaxRejections_, 1);
+        else
+            NERDLE_COUNT(board->counters()->valueRejections_, 1);
+        if (++retries == maxRandomTries_ || (deadline != kNoDeadline &&
+                chrono::steady_clock::now() >= deadline)) {
+            lastTry = "";
+            break;
+        }
+        eq = board->getEqCO();
+        lastTry = board->getEqAddWP(eq);
         // if only half of equation needs to be guess it can be brute-forced
         /*if (countUnderscores(lastTry) < length_ / 2) {
             vector<string> triedWPeqs;
@@ -50,14 +229,35 @@ std::string NerdleSolver::nextGuess(const NerdleGameState& gameState) {
                 board_.getEqBruteForce(lastTry);
             }
         } else {*/
-            lastTry = board_.getEqGuessRest(lastTry);
+            lastTry = board->getEqGuessRest(lastTry);
         //}
+        board->deriveRhs(&lastTry);
     }
-    lastGSSize_ = gameState.size();
+    NERDLE_COUNT(board->counters()->randomRetries_, retries);
+#ifdef NERDLE_COUNTERS
+    SolverCounters* counters = board->counters();
+    counters->maxTurnRetries_ = max<uint64_t>(counters->maxTurnRetries_,
+        retries);
+#endif
     return lastTry;
 }
 
-bool NerdleSolver::checkWin(const NerdleStatusRow& row) {
+string NerdleSolver::openingGuess(const int length) {
+    switch (length) {
+        case 8:
+            return "1+7*9=64";
+        case 9:
+            return "20+7*9=83";
+        case 10:
+            return "1+7*9-0=64";
+        case 11:
+            return "21+7*9-0=84";
+        default:
+            return "";
+    }
+}
+
+bool NerdleSolver::checkWin(const NerdleStatusRow& row) const {
     for (CharacterAndStatus cas : row) {
         if (cas.status_ != NerdleStatus::Correct)
             return false;
@@ -65,7 +265,7 @@ bool NerdleSolver::checkWin(const NerdleStatusRow& row) {
     return true;
 }
 
-bool NerdleSolver::checkSyntax(const string eq) const {
+bool NerdleSolver::checkSyntax(const string& eq) const {
     if (eq.length() != length_ || !isNum(eq.at(0)) || !isNum(eq.back()))
         return false;
     if (eq.at(0) == '0' && isNum(eq.at(1)))
@@ -95,7 +295,7 @@ bool NerdleSolver::checkSyntax(const string eq) const {
     return true;
 }
 
-bool NerdleSolver::checkCorrectEquation(const string eq) const {
+bool NerdleSolver::checkCorrectEquation(const string& eq) const {
     shared_ptr<vector<int>> nums = make_shared<vector<int>>();
     shared_ptr<vector<char>> ops = make_shared<vector<char>>();
     shared_ptr<vector<int>> order = make_shared<vector<int>>();
@@ -121,7 +321,7 @@ bool NerdleSolver::checkCorrectEquation(const string eq) const {
     return nums->at(nums->size() - 2) == nums->at(nums->size() - 1);
 }
 
-const int NerdleSolver::countUnderscores(const string eq) const {
+const int NerdleSolver::countUnderscores(const string& eq) const {
     int amount = 0;
     for (char c : eq) {
         if (c == '_')
@@ -130,8 +330,9 @@ const int NerdleSolver::countUnderscores(const string eq) const {
     return amount;
 }
 
-bool NerdleSolver::notTried(const vector<string> tried, const string eq) const {
-    for (string s : tried) {
+bool NerdleSolver::notTried(const vector<string>& tried,
+        const string& eq) const {
+    for (const string& s : tried) {
         if (s == eq)
             return false;
     }
@@ -152,7 +353,7 @@ bool NerdleSolver::safeMultiplication(const int lh, const int rh) const {
     return lh != 0 && rh != 0;
 }
 
-void NerdleSolver::splitEquation(const string eq, shared_ptr<vector<int>> nums,
+void NerdleSolver::splitEquation(const string& eq, shared_ptr<vector<int>> nums,
         shared_ptr<vector<char>> ops, shared_ptr<vector<int>> order) const {
     int curNum = 0;
     int dotOpAmount = 0;
@@ -6,42 +6,185 @@
 
 #include <gtest/gtest.h>
 #include <math.h>
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <vector>
 #include <string>
 #include "./NerdleBenchmark.h"
 #include "./Board.h"
+#include "./EquationUniverse.h"
+#include "./EquationValidator.h"
+#include "./GuessCache.h"
+#include "./GuessScorer.h"
+#include "./OpeningBook.h"
+#include "./SolverCounters.h"
+#include "./SolverEngine.h"
+#include "./WorkStealingPool.h"
 
 using namespace std;  // NOLINT
 
+// point in time by which a guess has to be ready
+using Deadline = chrono::steady_clock::time_point;
+constexpr Deadline kNoDeadline = Deadline::max();
+
 class NerdleSolver : public NerdleSolverBase {
  public:
     // For testing
     FRIEND_TEST(NerdleSolver, checkSyntax);
     FRIEND_TEST(NerdleSolver, checkCorrectEquation);
+    FRIEND_TEST(NerdleSolver, isValidEquation);
+    // For micro benchmarks
+    friend struct NerdleSolverBenchAccess;
     // setup solver for nerdle game where length is the lenght of the equations
-    explicit NerdleSolver(int length) : length_(length) { board_ = Board(length); }
+    explicit NerdleSolver(int length,
+            GuessStrategy strategy = GuessStrategy::Universe)
+            : NerdleSolver(SolverEngine::get(length, strategy)) {}
+    // setup solver that plays with the data of engine (which may be shared
+    // with other solvers)
+    explicit NerdleSolver(shared_ptr<const SolverEngine> engine)
+            : engine_(engine), length_(engine->length()),
+            strategy_(engine->strategy()) {
+        game_ = engine_->start();
+    }
     // generate the next guess for the nerdle game
     string nextGuess(const NerdleGameState& gameState) override;
+    // same as nextGuess but returns soon after deadline with the best guess
+    // found until then, finished is set to false if the strategy didnt get
+    // to look at everything it would have without deadline
+    // the guess is always a valid equation and the same as the one of
+    // nextGuess if finished is true
+    string nextGuess(const NerdleGameState& gameState, const Deadline deadline,
+        bool* finished);
+    // same as nextGuess but for the game kept in game, scorer is only used
+    // by GuessStrategy::Entropy, GuessStrategy::Minimax and
+    // GuessStrategy::MonteCarlo
+    // calls for different games and scorers can run at the same time
+    string nextGuess(const NerdleGameState& gameState, GameContext* game,
+        GuessScorer* scorer, const Deadline deadline = kNoDeadline,
+        bool* finished = nullptr) const;
+    // returns the context of a game that has just started (with the seed of
+    // this solver)
+    GameContext newGame() const;
+    // returns the context of a game that has seen every row of gameState but
+    // the last one, which nextGuess applies itself
+    GameContext gameAt(const NerdleGameState& gameState) const;
+    // makes the random guesses and the simulated games of this solver and of
+    // all games it starts reproducible, the same seed gives the same guesses
+    // no matter how many threads are used
+    void seed(const uint64_t seed);
+    int length() const { return length_; }
+    // returns the read-only data of the solver
+    const shared_ptr<const SolverEngine>& engine() const { return engine_; }
+    // returns what was counted for the games played through
+    // nextGuess(gameState) (see SolverCounters.h)
+    SolverCounters counters() const { return game_.counters(); }
+    // answer from book as long as the game stays inside of it and use the
+    // strategy afterwards (null removes the book), returns false and keeps
+    // the current book if book is for another length
+    bool useOpeningBook(shared_ptr<const OpeningBook> book) {
+        if (book && book->length() != static_cast<int>(length_))
+            return false;
+        engine_ = engine_->withBook(book);
+        return true;
+    }
+    // look up guesses in cache before computing them and remember the
+    // computed ones there (the cache may be shared with other solvers of the
+    // same engine and with other threads)
+    void useCache(shared_ptr<GuessCache> cache) { cache_ = cache; }
+    // returns the hard coded first guess for given equation length
+    static string openingGuess(const int length);
 
  private:
-    // saves the last size of gamestate (needed for new game detection)
-    unsigned int lastGSSize_ = 0;
-    // keeps track of the Game
-    Board board_;
+    // universe, opening book and start context (shared between solvers)
+    shared_ptr<const SolverEngine> engine_;
+    // the game played through nextGuess(gameState)
+    GameContext game_;
+    // guesses chosen before (may be null)
+    shared_ptr<GuessCache> cache_;
     // lenght of equations
     unsigned int length_;
+    // how guesses are generated
+    GuessStrategy strategy_;
+    // scorer of GuessStrategy::Entropy, GuessStrategy::Minimax and
+    // GuessStrategy::MonteCarlo (on the threads of the engine), made by
+    // scorer() on first use
+    unique_ptr<GuessScorer> scorer_;
+    // GuessStrategy::Entropy scores up to this many consistent and this many
+    // other equations against up to entropyAnswers_ consistent equations
+    static constexpr size_t entropyProbes_ = 500;
+    static constexpr size_t entropyOtherProbes_ = 100;
+    static constexpr size_t entropyAnswers_ = 5000;
+    // GuessStrategy::Minimax the same way, it looks at the follow-up guesses
+    // too if there are at most minimaxDeepAnswers_ answers
+    static constexpr size_t minimaxProbes_ = 300;
+    static constexpr size_t minimaxOtherProbes_ = 100;
+    static constexpr size_t minimaxAnswers_ = 5000;
+    static constexpr size_t minimaxDeepAnswers_ = 300;
+    // GuessStrategy::MonteCarlo simulates rollouts_ games for each of up to
+    // rolloutProbes_ consistent and rolloutOtherProbes_ other equations
+    // against up to rolloutAnswers_ consistent equations
+    static constexpr size_t rolloutProbes_ = 100;
+    static constexpr size_t rolloutOtherProbes_ = 50;
+    static constexpr size_t rolloutAnswers_ = 2000;
+    static constexpr size_t rollouts_ = 64;
+    // random guessing gives up after this many equations
+    static constexpr int maxRandomTries_ = 1000;
+    // with a deadline guesses are scored in chunks of this many and the time
+    // is checked between chunks
+    static constexpr size_t anytimeChunk_ = 32;
 
+    // starts a new game in game but keeps its counters
+    void restart(GameContext* game) const;
+    // returns the scorer of the game played through nextGuess(gameState)
+    // (null for strategies that dont score guesses)
+    GuessScorer* scorer();
+    // returns first equation of the universe that can still be the answer
+    // ("" if there is none)
+    string guessFromUniverse(const Board& board) const;
+    // returns the equation with the most expected information about the
+    // consistent equations ("" if there is none)
+    string guessByEntropy(const Board& board, GuessScorer* scorer,
+        const Deadline deadline, bool* finished) const;
+    // returns the equation that leaves the fewest consistent equations in the
+    // worst case ("" if there is none)
+    string guessByWorstCase(const Board& board, GuessScorer* scorer,
+        const Deadline deadline, bool* finished) const;
+    // returns the equation with the fewest guesses in games simulated with
+    // random ("" if there is none), turn t of a game uses stream 1 + t of
+    // its seed (stream 0 belongs to the board)
+    string guessByRollouts(const Board& board, GuessScorer* scorer,
+        const RandomStream& random, const Deadline deadline,
+        bool* finished) const;
+    // returns the best of guesses, best(chunk) returns the index of the best
+    // guess of a chunk of them (the first one on ties)
+    // the chunks are scored one after another until all are scored or
+    // deadline has passed (finished is set to false then), the best guess so
+    // far is put in front of every chunk so that it stays unless a later
+    // guess is better, just like scoring all guesses at once
+    template <typename Best>
+    string bestInChunks(const vector<string>& guesses,
+        const Deadline deadline, bool* finished, Best best) const;
+    // returns up to size candidates of board evenly spread over all of them
+    vector<string> candidateSample(const Board& board, const size_t size) const;
+    // returns up to consistent of the candidates followed by about other
+    // equations of the universe that contradict the hints
+    vector<string> probes(const Board& board, const size_t consistent,
+        const size_t other) const;
+    // guesses randomly until a valid equation is found
+    // returns "" if there is none after maxRandomTries_ or at deadline
+    string guessRandom(Board* board, const Deadline deadline) const;
     // check if current game was won
-    bool checkWin(const NerdleStatusRow& row);
+    bool checkWin(const NerdleStatusRow& row) const;
     // returns true if equation has correct syntax
-    bool checkSyntax(const string eq) const;
+    bool checkSyntax(const string& eq) const;
     // returns true if equation is mathamatically correct
-    bool checkCorrectEquation(const string eq) const;
+    bool checkCorrectEquation(const string& eq) const;
     // counts amount of _ in equation
-    const int countUnderscores(const string eq) const;
+    const int countUnderscores(const string& eq) const;
     // returns true if equation was not tried yet
-    bool notTried(const vector<string> tried, const string eq) const;
+    bool notTried(const vector<string>& tried,
+        const string& eq) const;
     // checks if char is a number
     bool isNum(const char c) const;
     // checks if int division is possible
@@ -50,10 +193,33 @@ class NerdleSolver : public NerdleSolverBase {
     bool safeMultiplication(const int lh, const int rh) const;
     // returns all numbers and symbols of given equation by reference
     // also gives the order of operations
-    void splitEquation(const string eq, shared_ptr<vector<int>> nums,
+    void splitEquation(const string& eq, shared_ptr<vector<int>> nums,
         shared_ptr<vector<char>> ops, shared_ptr<vector<int>> order) const;
     // performs given operation with given operands
     int performOp(const int lh, const int rh, const char op) const;
 };
 
+template <typename Best>
+string NerdleSolver::bestInChunks(const vector<string>& guesses,
+        const Deadline deadline, bool* finished, Best best) const {
+    // without deadline one chunk keeps all threads busy the longest
+    const size_t size = deadline == kNoDeadline ? guesses.size() :
+        anytimeChunk_;
+    size_t kept = 0;
+    for (size_t begin = 1; begin < guesses.size(); begin += size) {
+        if (chrono::steady_clock::now() >= deadline) {
+            *finished = false;
+            return guesses[kept];
+        }
+        const size_t end = min(guesses.size(), begin + size);
+        vector<string> chunk = {guesses[kept]};
+        chunk.insert(chunk.end(), guesses.begin() + begin,
+            guesses.begin() + end);
+        const size_t b = best(chunk);
+        if (b > 0)
+            kept = begin + b - 1;
+    }
+    return guesses[kept];
+}
+
 #endif  // NERDLESOLVER_H_
@@ -0,0 +1,180 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "./Board.h"
+#include "./EquationUniverse.h"
+#include "./HeadlessBenchmark.h"
+#include "./NerdleSolver.h"
+
+// every fixture uses fixed seeds so runs can be compared with each other
+constexpr unsigned int kSeed = 42;
+
+// gives the benchmarks access to the private checks of NerdleSolver
+struct NerdleSolverBenchAccess {
+    static bool checkSyntax(const NerdleSolver& s, const string& eq) {
+        return s.checkSyntax(eq);
+    }
+    static bool checkCorrectEquation(const NerdleSolver& s,
+            const string& eq) {
+        return s.checkCorrectEquation(eq);
+    }
+    static void splitEquation(const NerdleSolver& s, const string& eq) {
+        auto nums = make_shared<vector<int>>();
+        auto ops = make_shared<vector<char>>();
+        auto order = make_shared<vector<int>>();
+        s.splitEquation(eq, nums, ops, order);
+        benchmark::DoNotOptimize(nums->data());
+    }
+};
+
+// valid equations mixed with strings that break the syntax at a random
+// position, like the ones the random guessing produces
+vector<string> checkInputs(const int length) {
+    const string symbols = "0123456789+-*/=";
+    vector<string> eqs = sampleAnswers(length, 512, kSeed);
+    mt19937 random(kSeed);
+    for (size_t i = 0; i < eqs.size(); i += 2)
+        eqs[i][random() % length] = symbols[random() % symbols.size()];
+    return eqs;
+}
+
+// a game of given length after the opening guess
+NerdleGameState openedGame(const int length) {
+    const string answer = sampleAnswers(length, 1, kSeed).front();
+    const string opening = NerdleSolver::openingGuess(length);
+    return NerdleGameState{hintRow(opening, answer)};
+}
+
+void BM_checkSyntax(benchmark::State& state) {
+    NerdleSolver solver(state.range(0), GuessStrategy::Search);
+    const vector<string> eqs = checkInputs(state.range(0));
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(NerdleSolverBenchAccess::checkSyntax(solver,
+            eqs[i++ % eqs.size()]));
+    }
+}
+BENCHMARK(BM_checkSyntax)->DenseRange(8, 11);
+
+void BM_checkCorrectEquation(benchmark::State& state) {
+    NerdleSolver solver(state.range(0), GuessStrategy::Search);
+    const vector<string> eqs = sampleAnswers(state.range(0), 512, kSeed);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(NerdleSolverBenchAccess::checkCorrectEquation(
+            solver, eqs[i++ % eqs.size()]));
+    }
+}
+BENCHMARK(BM_checkCorrectEquation)->DenseRange(8, 11);
+
+void BM_splitEquation(benchmark::State& state) {
+    NerdleSolver solver(state.range(0), GuessStrategy::Search);
+    const vector<string> eqs = sampleAnswers(state.range(0), 512, kSeed);
+    size_t i = 0;
+    for (auto _ : state)
+        NerdleSolverBenchAccess::splitEquation(solver, eqs[i++ % eqs.size()]);
+}
+BENCHMARK(BM_splitEquation)->DenseRange(8, 11);
+
+void BM_isValidEquation(benchmark::State& state) {
+    const vector<string> eqs = checkInputs(state.range(0));
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(isValidEquation(eqs[i++ % eqs.size()],
+            state.range(0)));
+    }
+}
+BENCHMARK(BM_isValidEquation)->DenseRange(8, 11);
+
+// a board that tracks all equations gets the hints of the opening guess,
+// which filters its candidates
+void BM_BoardUpdate(benchmark::State& state) {
+    const int length = state.range(0);
+    const NerdleStatusRow row = openedGame(length).front();
+    Board start(length);
+    start.seed(kSeed);
+    start.trackCandidates(EquationUniverse::get(length));
+    for (auto _ : state) {
+        state.PauseTiming();
+        Board board = start;
+        state.ResumeTiming();
+        board.update(row);
+        benchmark::DoNotOptimize(&board);
+    }
+}
+BENCHMARK(BM_BoardUpdate)->DenseRange(8, 11);
+
+// one look-ahead branch: apply a hypothetical row and undo it again
+void BM_BoardWhatIf(benchmark::State& state) {
+    const int length = state.range(0);
+    const NerdleStatusRow row = openedGame(length).front();
+    Board board(length);
+    const BoardState start = board.snapshot();
+    for (auto _ : state) {
+        board.updateHints(row);
+        benchmark::DoNotOptimize(&board);
+        board.restore(start);
+    }
+}
+BENCHMARK(BM_BoardWhatIf)->DenseRange(8, 11);
+
+// the three steps of the random guessing after the opening guess
+void BM_getEqCO(benchmark::State& state) {
+    Board board(state.range(0));
+    board.seed(kSeed);
+    board.update(openedGame(state.range(0)).front());
+    for (auto _ : state)
+        benchmark::DoNotOptimize(board.getEqCO());
+}
+BENCHMARK(BM_getEqCO)->DenseRange(8, 11);
+
+void BM_getEqAddWP(benchmark::State& state) {
+    Board board(state.range(0));
+    board.seed(kSeed);
+    board.update(openedGame(state.range(0)).front());
+    const string co = board.getEqCO();
+    for (auto _ : state) {
+        board.getEqCO();
+        benchmark::DoNotOptimize(board.getEqAddWP(co));
+    }
+}
+BENCHMARK(BM_getEqAddWP)->DenseRange(8, 11);
+
+void BM_getEqGuessRest(benchmark::State& state) {
+    Board board(state.range(0));
+    board.seed(kSeed);
+    board.update(openedGame(state.range(0)).front());
+    for (auto _ : state) {
+        string eq = board.getEqAddWP(board.getEqCO());
+        benchmark::DoNotOptimize(board.getEqGuessRest(eq));
+    }
+}
+BENCHMARK(BM_getEqGuessRest)->DenseRange(8, 11);
+
+// the complete second turn of a game, starting from a new game context
+void BM_nextGuess(benchmark::State& state) {
+    const int length = state.range(0);
+    const GuessStrategy strategy = static_cast<GuessStrategy>(state.range(1));
+    NerdleSolver solver(length, strategy);
+    const NerdleGameState game = openedGame(length);
+    const GameContext fresh = solver.newGame();
+    unsigned int seed = kSeed;
+    for (auto _ : state) {
+        GameContext context = fresh;
+        context.board_.seed(seed++);
+        benchmark::DoNotOptimize(solver.nextGuess(game, &context, nullptr));
+    }
+}
+BENCHMARK(BM_nextGuess)
+    ->ArgsProduct({{8, 9, 10, 11},
+        {static_cast<int>(GuessStrategy::Random),
+         static_cast<int>(GuessStrategy::Universe),
+         static_cast<int>(GuessStrategy::Search)}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
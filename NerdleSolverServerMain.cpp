@@ -0,0 +1,47 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "./NerdleSolver.h"
+#include "./SolverServer.h"
+
+int main(int argc, char** argv) {
+    const auto usage = []() {
+        std::cerr << "Usage ./NerdleSolverServerMain <lengthOfExpressions> "
+            << "[random|universe|search|entropy|minimax|montecarlo] "
+            << "[socketPath|-] [threads]"
+            << std::endl
+            << "reads requests \"<id> <guess>:<hints> ...\" (hints G, M, B) "
+            << "and answers \"<id> <guess>\"," << std::endl
+            << "on stdin and stdout if there is no socket path" << std::endl;
+        std::exit(1);
+    };
+    if (argc < 2 || argc > 5)
+        usage();
+    const int length = std::atoi(argv[1]);
+    if (!isSupportedLength(length)) {
+        std::cerr << "Unsupported length " << argv[1] << std::endl;
+        std::exit(1);
+    }
+    GuessStrategy strategy = GuessStrategy::Universe;
+    if (argc >= 3 && !parseStrategy(argv[2], &strategy))
+        usage();
+    const std::string path = argc >= 4 ? argv[3] : "-";
+    const unsigned int threads = argc == 5 ? std::atoi(argv[4]) : 0;
+
+    // the tables are built once here and used for every request
+    NerdleSolver solver(length, strategy);
+    SolverServer server(&solver, threads);
+    if (path == "-") {
+        server.serve(std::cin, std::cout);
+        return 0;
+    }
+    if (!server.listen(path)) {
+        std::cerr << "Cannot listen on " << path << std::endl;
+        std::exit(1);
+    }
+    std::cerr << "Listening on " << path << std::endl;
+    server.wait();
+}
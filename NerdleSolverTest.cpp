@@ -2,8 +2,12 @@
 // Author: Henry Herröder
 
 #include <gtest/gtest.h>
+#include <chrono>
 #include <string>
+#include <vector>
 #include "./NerdleSolver.h"
+#include "./FeedbackPattern.h"
+#include "./HeadlessBenchmark.h"
 
 TEST(NerdleSolver, checkSyntax) {
     NerdleSolver solver(8);
@@ -27,3 +31,168 @@ TEST(NerdleSolver, checkCorrectEquation) {
     ASSERT_EQ(solver.safeDivision(505,92), false);
     ASSERT_EQ(solver.checkCorrectEquation(eq), false);
 }
+
+// isValidEquation has to accept exactly the equations that pass
+// checkSyntax and checkCorrectEquation
+TEST(NerdleSolver, isValidEquation) {
+    const string symbols = "0123456789+-*/=";
+    NerdleSolver solver(6, GuessStrategy::Random);
+    // every string of length 6
+    string eq(6, '0');
+    size_t idx[6] = {0};
+    while (true) {
+        for (size_t i = 0; i < eq.size(); ++i)
+            eq[i] = symbols[idx[i]];
+        bool expected = solver.checkSyntax(eq) &&
+            solver.checkCorrectEquation(eq);
+        ASSERT_EQ(isValidEquation(eq, 6), expected) << eq;
+        int i = 5;
+        while (i >= 0 && ++idx[i] == symbols.size())
+            idx[i--] = 0;
+        if (i < 0)
+            break;
+    }
+    // every equation of length 8 and everything one symbol away from it
+    NerdleSolver solver8(8, GuessStrategy::Random);
+    EquationUniverse universe(8);
+    for (string eq8 : universe.equations()) {
+        ASSERT_EQ(isValidEquation(eq8, 8), true) << eq8;
+        for (size_t i = 0; i < eq8.size(); ++i) {
+            char old = eq8[i];
+            for (char c : symbols) {
+                eq8[i] = c;
+                bool expected = solver8.checkSyntax(eq8) &&
+                    solver8.checkCorrectEquation(eq8);
+                ASSERT_EQ(isValidEquation(eq8, 8), expected) << eq8;
+            }
+            eq8[i] = old;
+        }
+    }
+    ASSERT_EQ(isValidEquation("45+45=90", 7), false);
+}
+
+// plays a game of given length against answer and returns the amount of
+// guesses needed (0 if the solver didnt find the answer within 20 guesses)
+int playGame(NerdleSolver* solver, const string& answer) {
+    NerdleGameState state;
+    for (int turn = 1; turn <= 20; ++turn) {
+        string guess = solver->nextGuess(state);
+        EXPECT_EQ(isValidEquation(guess, answer.size()), true) << guess;
+        int pattern = feedbackPattern(guess, answer);
+        if (isWinPattern(pattern, answer.size()))
+            return turn;
+        state.push_back(patternRow(guess, pattern));
+    }
+    return 0;
+}
+
+TEST(NerdleSolver, strategies) {
+    const vector<string> answers = {"12+35=47", "9*8-6=66", "0+10-9=1",
+        "100/4=25"};
+    for (GuessStrategy strategy : {GuessStrategy::Random,
+            GuessStrategy::Universe, GuessStrategy::Search,
+            GuessStrategy::Entropy, GuessStrategy::Minimax,
+            GuessStrategy::MonteCarlo}) {
+        NerdleSolver solver(8, strategy);
+        for (const string& answer : answers)
+            ASSERT_NE(playGame(&solver, answer), 0) << answer;
+    }
+}
+
+// the same seed gives the same games
+TEST(NerdleSolver, seed) {
+    for (GuessStrategy strategy : {GuessStrategy::Random,
+            GuessStrategy::MonteCarlo}) {
+        NerdleSolver first(8, strategy);
+        NerdleSolver second(8, strategy);
+        first.seed(11);
+        second.seed(11);
+        NerdleGameState state;
+        for (const string& answer : vector<string>{"9*8-6=66", "100/4=25"}) {
+            state.clear();
+            for (int turn = 0; turn < 6; ++turn) {
+                const string guess = first.nextGuess(state);
+                ASSERT_EQ(guess, second.nextGuess(state));
+                const int pattern = feedbackPattern(guess, answer);
+                if (isWinPattern(pattern, 8))
+                    break;
+                state.push_back(patternRow(guess, pattern));
+            }
+        }
+    }
+}
+
+// with a deadline the guess is valid in any case and the same as without one
+// if there was enough time
+TEST(NerdleSolver, deadline) {
+    const string answer = "48/6+25=33";
+    for (GuessStrategy strategy : {GuessStrategy::Entropy,
+            GuessStrategy::Minimax, GuessStrategy::MonteCarlo}) {
+        // every call plays the second turn of a new game
+        auto secondGuess = [&](const Deadline deadline, bool* finished) {
+            NerdleSolver solver(10, strategy);
+            solver.seed(4);
+            NerdleGameState state;
+            const string opening = solver.nextGuess(state);
+            state.push_back(hintRow(opening, answer));
+            return deadline == kNoDeadline ? solver.nextGuess(state) :
+                solver.nextGuess(state, deadline, finished);
+        };
+        const string best = secondGuess(kNoDeadline, nullptr);
+        bool finished = true;
+        const string early = secondGuess(chrono::steady_clock::now(),
+            &finished);
+        ASSERT_EQ(finished, false);
+        ASSERT_EQ(isValidEquation(early, 10), true) << early;
+        ASSERT_EQ(secondGuess(chrono::steady_clock::now() + chrono::minutes(1),
+            &finished), best);
+        ASSERT_EQ(finished, true);
+
+        auto start = chrono::steady_clock::now();
+        const string timed = secondGuess(start + chrono::milliseconds(5),
+            &finished);
+        ASSERT_EQ(isValidEquation(timed, 10), true) << timed;
+        ASSERT_LT(chrono::steady_clock::now() - start, chrono::seconds(1));
+    }
+}
+
+TEST(NerdleSolver, equationError) {
+    ASSERT_EQ(equationError("45+45=90", 8), EquationError::None);
+    ASSERT_EQ(equationError("45++5=90", 8), EquationError::Syntax);
+    ASSERT_EQ(equationError("05+45=50", 8), EquationError::Syntax);
+    ASSERT_EQ(equationError("45+45=90", 9), EquationError::Syntax);
+    ASSERT_EQ(equationError("45+45=91", 8), EquationError::Value);
+    ASSERT_EQ(equationError("505/92=6", 8), EquationError::Value);
+    ASSERT_EQ(equationError("0*5+1=01", 8), EquationError::Value);
+}
+
+// the counters only count if they are compiled in
+TEST(NerdleSolver, counters) {
+    NerdleSolver solver(8, GuessStrategy::Random);
+    for (const char* answer : {"12+35=47", "9*8-6=66", "100/4=25"})
+        playGame(&solver, answer);
+    SolverCounters counters = solver.counters();
+    if (SolverCounters::enabled()) {
+        ASSERT_GT(counters.updates_, 0u);
+        ASSERT_GT(counters.syntaxRejections_ + counters.valueRejections_, 0u);
+        ASSERT_EQ(counters.randomRetries_,
+            counters.syntaxRejections_ + counters.valueRejections_);
+    } else {
+        ASSERT_EQ(counters.updates_, 0u);
+        ASSERT_EQ(counters.randomRetries_, 0u);
+    }
+    ASSERT_NE(counters.toJson().find("\"updates\""), string::npos);
+}
+
+TEST(NerdleSolver, lhsValue) {
+    int64_t value;
+    int ops;
+    ASSERT_EQ(lhsValue("3+4*5-6/2", &value, &ops), EquationError::None);
+    ASSERT_EQ(value, 20);
+    ASSERT_EQ(ops, 4);
+    ASSERT_EQ(lhsValue("42", &value, &ops), EquationError::None);
+    ASSERT_EQ(ops, 0);
+    ASSERT_EQ(lhsValue("7/2", &value, &ops), EquationError::Value);
+    ASSERT_EQ(lhsValue("07+1", &value, &ops), EquationError::Syntax);
+    ASSERT_EQ(lhsValue("7+", &value, &ops), EquationError::Syntax);
+}
@@ -0,0 +1,84 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef NERDLESYMBOLS_H_
+#define NERDLESYMBOLS_H_
+
+#include <array>
+#include <cstdint>
+
+// the nerdle alphabet "0123456789+-*/=" indexed from 0 to 14
+constexpr int kSymbols = 15;
+// minimum and maximum equation length a Board can keep track of
+constexpr int kMinLength = 5;
+constexpr int kMaxLength = 16;
+
+// one bit per symbol index
+using SymbolMask = uint16_t;
+constexpr SymbolMask kNumMask = 0x03FF;
+constexpr SymbolMask kOpMask = 0x3C00;
+constexpr SymbolMask kEqualsMask = 0x4000;
+constexpr SymbolMask kAllMask = kNumMask | kOpMask | kEqualsMask;
+
+// returns index of symbol c (-1 if c isnt part of the alphabet)
+constexpr int symbolIndex(const char c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    switch (c) {
+        case '+':
+            return 10;
+        case '-':
+            return 11;
+        case '*':
+            return 12;
+        case '/':
+            return 13;
+        case '=':
+            return 14;
+        default:
+            return -1;
+    }
+}
+
+// returns symbol of given index
+constexpr char symbolChar(const int index) {
+    return "0123456789+-*/="[index];
+}
+
+// returns mask with only the bit of c set
+constexpr SymbolMask symbolBit(const char c) {
+    return static_cast<SymbolMask>(1u << symbolIndex(c));
+}
+
+// symbols allowed at every position before the first hint
+constexpr std::array<SymbolMask, kMaxLength> initialAllowed(const int length) {
+    std::array<SymbolMask, kMaxLength> allowed = {};
+    for (int i = 0; i < length; ++i) {
+        allowed[i] = kNumMask;
+        // first and last 2 posses cant have defOps
+        if (i >= 1 && i < length - 2)
+            allowed[i] |= kOpMask;
+        // first half and last pos cant have =
+        if (i >= length / 2 && i < length - 1)
+            allowed[i] |= kEqualsMask;
+    }
+    return allowed;
+}
+
+// initialAllowed for every length up to kMaxLength, built by the compiler
+constexpr std::array<std::array<SymbolMask, kMaxLength>, kMaxLength + 1>
+        initialAllowedTable() {
+    std::array<std::array<SymbolMask, kMaxLength>, kMaxLength + 1> table = {};
+    for (int length = 0; length <= kMaxLength; ++length)
+        table[length] = initialAllowed(length);
+    return table;
+}
+constexpr auto kInitialAllowed = initialAllowedTable();
+
+// returns true if the solver has an opening guess and tables for equations
+// of length (the Board alone works from kMinLength to kMaxLength)
+constexpr bool isSupportedLength(const int length) {
+    return length >= 8 && length <= 11;
+}
+
+#endif  // NERDLESYMBOLS_H_
@@ -0,0 +1,184 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include "./OpeningBook.h"
+#include "./FeedbackPattern.h"
+#include "./NerdleSymbols.h"
+
+namespace {
+const char kMagic[4] = {'N', 'R', 'D', 'B'};
+const uint32_t kVersion = 1;
+// the answers scored per node, like GuessStrategy::Entropy
+const size_t kBookAnswers = 5000;
+
+// node of the tree that still has to be added
+struct PendingNode {
+    vector<uint32_t> answers_;
+    string guess_;
+    int depth_;
+};
+
+// writes all elements of v to out
+template <typename T>
+void writeArray(ofstream* out, const vector<T>& v) {
+    out->write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T));
+}
+
+// reads size elements from in into v
+template <typename T>
+bool readArray(ifstream* in, vector<T>* v, const size_t size) {
+    v->resize(size);
+    in->read(reinterpret_cast<char*>(v->data()), size * sizeof(T));
+    return static_cast<bool>(*in);
+}
+}  // namespace
+
+OpeningBook OpeningBook::build(const vector<string>& universe,
+        const string& first, const int depth, GuessScorer* scorer,
+        const size_t probes) {
+    OpeningBook book;
+    book.length_ = first.size();
+    book.firstEdge_.push_back(0);
+    // nodes are added level by level, so the edges of every node are next to
+    // each other and the children of a node get consecutive indices
+    deque<PendingNode> pending;
+    PendingNode root;
+    root.answers_.resize(universe.size());
+    for (size_t i = 0; i < universe.size(); ++i)
+        root.answers_[i] = i;
+    root.guess_ = first;
+    root.depth_ = 1;
+    pending.push_back(move(root));
+    uint32_t nodes = 1;
+    while (!pending.empty()) {
+        PendingNode node = move(pending.front());
+        pending.pop_front();
+        book.guesses_.insert(book.guesses_.end(), node.guess_.begin(),
+            node.guess_.end());
+        if (node.depth_ < depth) {
+            map<uint32_t, vector<uint32_t>> buckets;
+            for (const uint32_t a : node.answers_)
+                buckets[feedbackPattern(node.guess_, universe[a])].push_back(a);
+            for (auto& [pattern, answers] : buckets) {
+                if (isWinPattern(pattern, book.length_))
+                    continue;
+                PendingNode child;
+                child.guess_ = universe[answers.front()];
+                if (answers.size() > 2) {
+                    vector<string> left;
+                    for (const uint32_t a : answers)
+                        left.push_back(universe[a]);
+                    // consistent equations come first so they win ties
+                    vector<string> guesses = spreadSample(left, probes);
+                    vector<string> others = spreadSample(universe, probes / 5);
+                    guesses.insert(guesses.end(), others.begin(),
+                        others.end());
+                    child.guess_ = guesses.at(scorer->bestByEntropy(guesses,
+                        spreadSample(left, kBookAnswers)));
+                }
+                child.answers_ = move(answers);
+                child.depth_ = node.depth_ + 1;
+                book.edgePattern_.push_back(pattern);
+                book.edgeChild_.push_back(nodes++);
+                pending.push_back(move(child));
+            }
+        }
+        book.firstEdge_.push_back(book.edgePattern_.size());
+    }
+    return book;
+}
+
+string OpeningBook::guess(const NerdleGameState& gameState) const {
+    if (nodes() == 0)
+        return "";
+    uint32_t node = 0;
+    for (const NerdleStatusRow& row : gameState) {
+        if (row.size() != static_cast<size_t>(length_))
+            return "";
+        for (int i = 0; i < length_; ++i) {
+            if (row[i].character_ != guesses_[node * length_ + i])
+                return "";
+        }
+        const uint32_t pattern = rowPattern(row);
+        auto begin = edgePattern_.begin() + firstEdge_[node];
+        auto end = edgePattern_.begin() + firstEdge_[node + 1];
+        auto edge = lower_bound(begin, end, pattern);
+        if (edge == end || *edge != pattern)
+            return "";
+        node = edgeChild_[edge - edgePattern_.begin()];
+    }
+    return string(&guesses_[node * length_], length_);
+}
+
+bool OpeningBook::load(const string& path) {
+    ifstream in(path, ios::binary | ios::ate);
+    const streamoff fileSize = in.tellg();
+    in.seekg(0);
+    char magic[4];
+    uint32_t header[4];
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!in || memcmp(magic, kMagic, sizeof(magic)) != 0 ||
+            header[0] != kVersion || header[1] < 1 || header[1] > kMaxLength)
+        return false;
+    const int length = header[1];
+    const uint64_t nodes = header[2];
+    const uint64_t edges = header[3];
+    // the counts decide the size of the file, so a truncated or corrupt file
+    // is rejected before anything is allocated
+    const uint64_t expected = sizeof(magic) + sizeof(header) + nodes * length +
+        (nodes + 1 + 2 * edges) * sizeof(uint32_t);
+    if (nodes == 0 || static_cast<uint64_t>(fileSize) != expected)
+        return false;
+    vector<char> guesses;
+    vector<uint32_t> firstEdge, edgePattern, edgeChild;
+    if (!readArray(&in, &guesses, nodes * length) ||
+            !readArray(&in, &firstEdge, nodes + 1) ||
+            !readArray(&in, &edgePattern, edges) ||
+            !readArray(&in, &edgeChild, edges))
+        return false;
+    // guess relies on all of these
+    for (const char c : guesses) {
+        if (symbolIndex(c) < 0)
+            return false;
+    }
+    if (firstEdge.front() != 0 || firstEdge.back() != edges ||
+            !is_sorted(firstEdge.begin(), firstEdge.end()))
+        return false;
+    const uint32_t patterns = patternCount(length);
+    for (uint64_t node = 0; node < nodes; ++node) {
+        for (uint32_t e = firstEdge[node]; e < firstEdge[node + 1]; ++e) {
+            if (edgePattern[e] >= patterns || edgeChild[e] >= nodes ||
+                    (e > firstEdge[node] &&
+                    edgePattern[e - 1] >= edgePattern[e]))
+                return false;
+        }
+    }
+    length_ = length;
+    guesses_ = move(guesses);
+    firstEdge_ = move(firstEdge);
+    edgePattern_ = move(edgePattern);
+    edgeChild_ = move(edgeChild);
+    return true;
+}
+
+bool OpeningBook::save(const string& path) const {
+    ofstream out(path, ios::binary);
+    const uint32_t header[4] = {kVersion, static_cast<uint32_t>(length_),
+        static_cast<uint32_t>(nodes()),
+        static_cast<uint32_t>(edgePattern_.size())};
+    out.write(kMagic, sizeof(kMagic));
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    writeArray(&out, guesses_);
+    writeArray(&out, firstEdge_);
+    writeArray(&out, edgePattern_);
+    writeArray(&out, edgeChild_);
+    return static_cast<bool>(out);
+}
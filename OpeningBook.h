@@ -0,0 +1,57 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef OPENINGBOOK_H_
+#define OPENINGBOOK_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "./NerdleBenchmark.h"
+#include "./GuessScorer.h"
+
+using namespace std;  // NOLINT
+
+// decision tree of the first guesses of a game: every node holds a guess
+// and one child per pattern (see FeedbackPattern.h) that can follow it
+// the file format is a header ("NRDB", version, length, amount of nodes and
+// edges as uint32) followed by the arrays of the class in that order
+class OpeningBook {
+ public:
+    // builds the tree for all equations of universe starting with first
+    // every node picks the guess with the highest entropy over its remaining
+    // equations (using up to probes consistent equations as guesses) and the
+    // tree stops after depth guesses
+    static OpeningBook build(const vector<string>& universe,
+        const string& first, const int depth, GuessScorer* scorer,
+        const size_t probes);
+    // returns the guess of the tree for gameState or "" if the game has
+    // left the tree
+    string guess(const NerdleGameState& gameState) const;
+    // reads and writes the binary file, return false if that fails
+    // load also fails for files that arent a consistent tree and keeps the
+    // book unchanged then
+    bool load(const string& path);
+    bool save(const string& path) const;
+    int length() const { return length_; }
+    size_t nodes() const { return firstEdge_.empty() ? 0 :
+        firstEdge_.size() - 1; }
+
+ private:
+    int length_ = 0;
+    // guess of node i are the length_ chars from i * length_ on
+    vector<char> guesses_;
+    // edges of node i are firstEdge_[i] to firstEdge_[i + 1] - 1, sorted by
+    // pattern
+    vector<uint32_t> firstEdge_;
+    vector<uint32_t> edgePattern_;
+    vector<uint32_t> edgeChild_;
+
+    // adds a node that guesses among answers and its subtree
+    // returns the index of the node
+    uint32_t addNode(const vector<string>& universe,
+        const vector<string>& answers, const string& guess, const int depth,
+        GuessScorer* scorer, const size_t probes);
+};
+
+#endif  // OPENINGBOOK_H_
@@ -0,0 +1,40 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "./EquationUniverse.h"
+#include "./GuessScorer.h"
+#include "./NerdleSolver.h"
+#include "./OpeningBook.h"
+#include "./WorkStealingPool.h"
+
+// builds the opening book for one equation length and writes it to a file
+int main(int argc, char** argv) {
+    if (argc < 3 || argc > 5) {
+        std::cerr << "Usage ./OpeningBookMain <lengthOfExpressions> <file> "
+            << "[depth] [probes]" << std::endl;
+        std::exit(1);
+    }
+    const int length = std::atoi(argv[1]);
+    const int depth = argc >= 4 ? std::atoi(argv[3]) : 2;
+    const size_t probes = argc == 5 ? std::atoi(argv[4]) : 100;
+    const string first = NerdleSolver::openingGuess(length);
+    if (first.empty() || depth < 1) {
+        std::cerr << "Length has to be 8 to 11 and depth at least 1"
+            << std::endl;
+        std::exit(1);
+    }
+    WorkStealingPool pool;
+    GuessScorer scorer(length, &pool);
+    OpeningBook book = OpeningBook::build(
+        EquationUniverse::get(length)->equations(), first, depth, &scorer,
+        probes);
+    if (!book.save(argv[2])) {
+        std::cerr << "Cannot write " << argv[2] << std::endl;
+        std::exit(1);
+    }
+    std::cout << "Wrote " << book.nodes() << " nodes to " << argv[2]
+        << std::endl;
+}
@@ -0,0 +1,133 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+#include "./OpeningBook.h"
+#include "./EquationUniverse.h"
+#include "./EquationValidator.h"
+#include "./FeedbackPattern.h"
+#include "./NerdleSolver.h"
+
+TEST(OpeningBook, build) {
+    const vector<string>& all = EquationUniverse::get(8)->equations();
+    WorkStealingPool pool(2);
+    GuessScorer scorer(8, &pool);
+    OpeningBook book = OpeningBook::build(all, "1+7*9=64", 3, &scorer, 20);
+    ASSERT_EQ(book.guess(NerdleGameState()), "1+7*9=64");
+    ASSERT_GT(book.nodes(), 1u);
+
+    const string path = "OpeningBookTest.bin";
+    ASSERT_EQ(book.save(path), true);
+    OpeningBook loaded;
+    ASSERT_EQ(loaded.load(path), true);
+    remove(path.c_str());
+    ASSERT_EQ(loaded.nodes(), book.nodes());
+
+    // every game stays in the tree for three guesses, which are valid and
+    // consistent with the hints so far
+    for (size_t a = 0; a < all.size(); a += 101) {
+        NerdleGameState state;
+        for (int turn = 0; turn < 3; ++turn) {
+            string guess = loaded.guess(state);
+            ASSERT_EQ(guess, book.guess(state));
+            ASSERT_EQ(isValidEquation(guess, 8), true) << guess;
+            int pattern = feedbackPattern(guess, all[a]);
+            if (isWinPattern(pattern, 8))
+                break;
+            state.push_back(patternRow(guess, pattern));
+        }
+        if (state.size() == 3) {
+            ASSERT_EQ(loaded.guess(state), "");
+        }
+    }
+    // a different first guess leaves the tree
+    NerdleGameState other;
+    other.push_back(patternRow("12+35=47", 0));
+    ASSERT_EQ(loaded.guess(other), "");
+    ASSERT_EQ(loaded.load("doesNotExist.bin"), false);
+}
+
+TEST(OpeningBook, solver) {
+    const vector<string>& all = EquationUniverse::get(8)->equations();
+    WorkStealingPool pool(1);
+    GuessScorer scorer(8, &pool);
+    auto book = make_shared<const OpeningBook>(
+        OpeningBook::build(all, "1+7*9=64", 2, &scorer, 20));
+    NerdleSolver solver(8);
+    ASSERT_EQ(solver.useOpeningBook(book), true);
+    // a book of another length would give guesses of that length
+    NerdleSolver other(9);
+    ASSERT_EQ(other.useOpeningBook(book), false);
+    ASSERT_EQ(other.engine()->book(), nullptr);
+    for (size_t a = 0; a < all.size(); a += 997) {
+        NerdleGameState state;
+        for (int turn = 0; turn < 10; ++turn) {
+            string guess = solver.nextGuess(state);
+            if (turn < 2) {
+                ASSERT_EQ(guess, book->guess(state));
+            }
+            ASSERT_EQ(isValidEquation(guess, 8), true) << guess;
+            int pattern = feedbackPattern(guess, all[a]);
+            if (isWinPattern(pattern, 8))
+                break;
+            ASSERT_LT(turn, 9) << all[a];
+            state.push_back(patternRow(guess, pattern));
+        }
+    }
+}
+
+TEST(OpeningBook, corrupt) {
+    const vector<string>& all = EquationUniverse::get(8)->equations();
+    WorkStealingPool pool(1);
+    GuessScorer scorer(8, &pool);
+    OpeningBook book = OpeningBook::build(all, "1+7*9=64", 2, &scorer, 20);
+    const string path = "OpeningBookCorrupt.bin";
+    ASSERT_EQ(book.save(path), true);
+    ifstream in(path, ios::binary);
+    const string good((istreambuf_iterator<char>(in)),
+        istreambuf_iterator<char>());
+    in.close();
+    const size_t nodes = book.nodes();
+    const size_t edges = nodes - 1;
+    const size_t firstEdge = 20 + nodes * 8;
+    const size_t edgePattern = firstEdge + (nodes + 1) * 4;
+    const size_t edgeChild = edgePattern + edges * 4;
+    // writes good with the uint32 at offset replaced by value and loads it
+    auto loadWith = [&](const size_t offset, const uint32_t value) {
+        string data = good;
+        memcpy(&data[offset], &value, sizeof(value));
+        ofstream(path, ios::binary) << data;
+        OpeningBook loaded;
+        return loaded.load(path);
+    };
+    ASSERT_EQ(loadWith(0, 0x4244524E), true);
+    // counts that dont fit the file
+    ASSERT_EQ(loadWith(12, 0xFFFFFFFF), false);
+    ASSERT_EQ(loadWith(16, edges + 1), false);
+    // lengths
+    ASSERT_EQ(loadWith(8, 0), false);
+    ASSERT_EQ(loadWith(8, 17), false);
+    // a guess char outside of the alphabet
+    ASSERT_EQ(loadWith(20, 0x41414141), false);
+    // edges that arent monotonic or dont end at the amount of edges
+    ASSERT_EQ(loadWith(firstEdge, 1), false);
+    ASSERT_EQ(loadWith(firstEdge + 4, edges + 1), false);
+    ASSERT_EQ(loadWith(firstEdge + nodes * 4, edges - 1), false);
+    // patterns that dont exist or arent sorted and children that dont exist
+    ASSERT_EQ(loadWith(edgePattern, patternCount(8)), false);
+    ASSERT_EQ(loadWith(edgePattern, patternCount(8) - 1), false);
+    ASSERT_EQ(loadWith(edgeChild, nodes), false);
+    // a truncated file
+    ofstream(path, ios::binary) << good.substr(0, good.size() - 1);
+    OpeningBook loaded;
+    ASSERT_EQ(loaded.load(path), false);
+    ASSERT_EQ(loaded.nodes(), 0u);
+    remove(path.c_str());
+}
@@ -0,0 +1,89 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef PACKEDEQUATION_H_
+#define PACKEDEQUATION_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "./NerdleSymbols.h"
+
+using namespace std;  // NOLINT
+
+// an equation of up to kMaxLength symbols in one integer: 4 bits per
+// position, position 0 in the highest 4 bits and every unused position 0xF
+// the codes of the symbols follow their ascii order ("*+-/0123456789="), so
+// packed equations of one length sort like their strings
+using PackedEquation = uint64_t;
+
+// code of unused positions and of chars outside of the alphabet
+constexpr int kPackedNone = 0xF;
+
+// returns the code of c (kPackedNone if c isnt part of the alphabet)
+constexpr int packedCode(const char c) {
+    if (c >= '0' && c <= '9')
+        return c - '0' + 4;
+    switch (c) {
+        case '*':
+            return 0;
+        case '+':
+            return 1;
+        case '-':
+            return 2;
+        case '/':
+            return 3;
+        case '=':
+            return 14;
+        default:
+            return kPackedNone;
+    }
+}
+
+// char of every code ('_' for kPackedNone)
+constexpr char kPackedChars[17] = "*+-/0123456789=_";
+
+constexpr int packedShift(const int i) { return 60 - 4 * i; }
+
+// returns eq (with at most kMaxLength chars) packed
+constexpr PackedEquation packEquation(const string_view eq) {
+    PackedEquation p = ~PackedEquation(0);
+    for (size_t i = 0; i < eq.size(); ++i) {
+        p &= ~(PackedEquation(0xF) << packedShift(i));
+        p |= PackedEquation(packedCode(eq[i])) << packedShift(i);
+    }
+    return p;
+}
+
+// returns the code at position i
+constexpr int packedAt(const PackedEquation p, const int i) {
+    return (p >> packedShift(i)) & 0xF;
+}
+
+// returns the symbol index (see NerdleSymbols.h) at position i
+constexpr int packedSymbol(const PackedEquation p, const int i) {
+    return symbolIndex(kPackedChars[packedAt(p, i)]);
+}
+
+// returns the amount of used positions
+constexpr int packedLength(const PackedEquation p) {
+    return ~p == 0 ? 0 : kMaxLength - __builtin_ctzll(~p) / 4;
+}
+
+// returns the equation as string
+inline string unpackEquation(const PackedEquation p) {
+    string eq(packedLength(p), '_');
+    for (size_t i = 0; i < eq.size(); ++i)
+        eq[i] = kPackedChars[packedAt(p, i)];
+    return eq;
+}
+
+// returns a hash with all bits of p mixed into every bit (splitmix64)
+constexpr uint64_t packedHash(PackedEquation p) {
+    p = (p ^ (p >> 30)) * 0xBF58476D1CE4E5B9ull;
+    p = (p ^ (p >> 27)) * 0x94D049BB133111EBull;
+    return p ^ (p >> 31);
+}
+
+#endif  // PACKEDEQUATION_H_
@@ -0,0 +1,50 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "./EquationUniverse.h"
+#include "./FeedbackPattern.h"
+#include "./PackedEquation.h"
+
+TEST(PackedEquation, roundTrip) {
+    for (const string eq : {"", "1+1=2", "12+35=47", "0123456789+-*/=4",
+            "10*10-99=1"}) {
+        const PackedEquation p = packEquation(eq);
+        ASSERT_EQ(packedLength(p), static_cast<int>(eq.size())) << eq;
+        ASSERT_EQ(unpackEquation(p), eq);
+        for (size_t i = 0; i < eq.size(); ++i) {
+            ASSERT_EQ(packedSymbol(p, i), symbolIndex(eq[i])) << eq;
+            ASSERT_EQ(kPackedChars[packedAt(p, i)], eq[i]) << eq;
+        }
+    }
+    static_assert(packEquation("1+1=2") == 0x515E6FFFFFFFFFFFull, "");
+    ASSERT_NE(packedHash(packEquation("1+1=2")),
+        packedHash(packEquation("1+2=3")));
+}
+
+// packed equations sort like their strings
+TEST(PackedEquation, order) {
+    const vector<string> all = EquationUniverse::get(8)->equations();
+    ASSERT_EQ(is_sorted(all.begin(), all.end()), true);
+    const vector<PackedEquation>& packed = EquationUniverse::get(8)->packed();
+    ASSERT_EQ(is_sorted(packed.begin(), packed.end()), true);
+    const string symbols = "*+-/0123456789=";
+    for (size_t i = 1; i < symbols.size(); ++i) {
+        ASSERT_LT(packEquation(symbols.substr(i - 1, 1)),
+            packEquation(symbols.substr(i, 1)));
+    }
+}
+
+TEST(PackedEquation, feedbackPattern) {
+    const vector<string> all = EquationUniverse::get(8)->equations();
+    for (size_t g = 0; g < all.size(); g += 1231) {
+        const PackedEquation guess = packEquation(all[g]);
+        for (size_t a = 0; a < all.size(); a += 97) {
+            ASSERT_EQ(feedbackPattern(guess, packEquation(all[a])),
+                feedbackPattern(all[g], all[a])) << all[g] << " " << all[a];
+        }
+    }
+}
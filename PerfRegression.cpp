@@ -0,0 +1,179 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <cctype>
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "./PerfRegression.h"
+
+string PerfCase::toJson() const {
+    ostringstream out;
+    out << "{\"length\": " << length_
+        << ", \"strategy\": \"" << strategyName(strategy_) << "\""
+        << ", \"games\": " << games_ << ", \"seed\": " << seed_
+        << ", \"averageGuesses\": " << averageGuesses_
+        << ", \"maxGuesses\": " << maxGuesses_
+        << ", \"failures\": " << failures_
+        << ", \"seconds\": " << seconds_
+        << ", \"p99Ns\": " << p99Ns_ << "}";
+    return out.str();
+}
+
+PerfCase measurePerfCase(const PerfCase& c, NerdleSolverBase* solver) {
+    BenchmarkResult result = runHeadlessBenchmark(solver,
+        sampleAnswers(c.length_, c.games_, c.seed_));
+    PerfCase measured = c;
+    measured.averageGuesses_ = result.averageGuesses();
+    measured.maxGuesses_ = result.maxGuesses();
+    measured.failures_ = result.failures_;
+    measured.seconds_ = result.seconds_;
+    measured.p99Ns_ = result.latencyPercentile(0.99);
+    return measured;
+}
+
+vector<PerfCheck> comparePerfCase(const PerfCase& baseline,
+        const PerfCase& measured, const PerfThresholds& thresholds) {
+    const double slower = 1 + thresholds.time_;
+    return {
+        {"averageGuesses", baseline.averageGuesses_, measured.averageGuesses_,
+            baseline.averageGuesses_ + thresholds.averageGuesses_},
+        {"maxGuesses", static_cast<double>(baseline.maxGuesses_),
+            static_cast<double>(measured.maxGuesses_),
+            static_cast<double>(baseline.maxGuesses_ +
+                thresholds.maxGuesses_)},
+        {"failures", static_cast<double>(baseline.failures_),
+            static_cast<double>(measured.failures_),
+            static_cast<double>(baseline.failures_ + thresholds.failures_)},
+        {"seconds", baseline.seconds_, measured.seconds_,
+            baseline.seconds_ * slower + thresholds.secondsSlack_},
+        {"p99Ns", static_cast<double>(baseline.p99Ns_),
+            static_cast<double>(measured.p99Ns_),
+            baseline.p99Ns_ * slower + thresholds.p99SlackNs_}};
+}
+
+string formatPerfChecks(const PerfCase& c, const vector<PerfCheck>& checks) {
+    ostringstream out;
+    out << "length " << c.length_ << " " << strategyName(c.strategy_) << " ("
+        << c.games_ << " games, seed " << c.seed_ << ")\n";
+    out << "  " << left << setw(16) << "value" << right << setw(14)
+        << "baseline" << setw(14) << "measured" << "\n";
+    // enough digits for nanoseconds
+    out << setprecision(10);
+    for (const PerfCheck& check : checks) {
+        out << "  " << left << setw(16) << check.name_ << right
+            << setw(14) << check.baseline_ << setw(14) << check.measured_;
+        if (check.passed()) {
+            out << "  ok\n";
+        } else {
+            const double change = check.baseline_ == 0 ? 0 :
+                (check.measured_ / check.baseline_ - 1) * 100;
+            out << "  FAILED (" << showpos << fixed << setprecision(1)
+                << change << "%, limit " << noshowpos << defaultfloat
+                << setprecision(10) << check.limit_ << ")\n";
+        }
+    }
+    return out.str();
+}
+
+namespace {
+// reads the flat json object that starts at text[*pos] into values (numbers
+// and strings both as text), returns false if there is none
+bool parseObject(const string& text, size_t* pos,
+        map<string, string>* values) {
+    size_t& p = *pos;
+    auto skipSpace = [&]() {
+        while (p < text.size() && isspace(text[p]))
+            ++p;
+    };
+    auto readString = [&](string* s) {
+        if (p >= text.size() || text[p] != '"')
+            return false;
+        size_t end = text.find('"', p + 1);
+        if (end == string::npos)
+            return false;
+        *s = text.substr(p + 1, end - p - 1);
+        p = end + 1;
+        return true;
+    };
+    skipSpace();
+    if (p >= text.size() || text[p] != '{')
+        return false;
+    ++p;
+    skipSpace();
+    while (p < text.size() && text[p] != '}') {
+        string key, value;
+        skipSpace();
+        if (!readString(&key))
+            return false;
+        skipSpace();
+        if (p >= text.size() || text[p] != ':')
+            return false;
+        ++p;
+        skipSpace();
+        if (p < text.size() && text[p] == '"') {
+            if (!readString(&value))
+                return false;
+        } else {
+            while (p < text.size() && text[p] != ',' && text[p] != '}' &&
+                    !isspace(text[p]))
+                value.push_back(text[p++]);
+        }
+        (*values)[key] = value;
+        skipSpace();
+        if (p < text.size() && text[p] == ',')
+            ++p;
+    }
+    if (p >= text.size())
+        return false;
+    ++p;
+    return true;
+}
+}  // namespace
+
+bool parsePerfBaseline(const string& text, vector<PerfCase>* cases) {
+    cases->clear();
+    size_t p = text.find('[');
+    if (p == string::npos)
+        return false;
+    ++p;
+    while (true) {
+        while (p < text.size() && (isspace(text[p]) || text[p] == ','))
+            ++p;
+        if (p < text.size() && text[p] == ']')
+            return true;
+        map<string, string> values;
+        if (!parseObject(text, &p, &values))
+            return false;
+        for (const char* key : {"length", "strategy", "games", "seed",
+                "averageGuesses", "maxGuesses", "failures", "seconds",
+                "p99Ns"}) {
+            if (!values.count(key))
+                return false;
+        }
+        PerfCase c;
+        c.length_ = atoi(values["length"].c_str());
+        if (!parseStrategy(values["strategy"], &c.strategy_))
+            return false;
+        c.games_ = strtoull(values["games"].c_str(), nullptr, 10);
+        c.seed_ = strtoul(values["seed"].c_str(), nullptr, 10);
+        c.averageGuesses_ = atof(values["averageGuesses"].c_str());
+        c.maxGuesses_ = strtoull(values["maxGuesses"].c_str(), nullptr, 10);
+        c.failures_ = strtoull(values["failures"].c_str(), nullptr, 10);
+        c.seconds_ = atof(values["seconds"].c_str());
+        c.p99Ns_ = strtoull(values["p99Ns"].c_str(), nullptr, 10);
+        cases->push_back(c);
+    }
+}
+
+string writePerfBaseline(const vector<PerfCase>& cases) {
+    string out = "[\n";
+    for (size_t i = 0; i < cases.size(); ++i) {
+        out += "  " + cases[i].toJson();
+        out += i + 1 < cases.size() ? ",\n" : "\n";
+    }
+    return out + "]\n";
+}
@@ -0,0 +1,76 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef PERFREGRESSION_H_
+#define PERFREGRESSION_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "./HeadlessBenchmark.h"
+#include "./NerdleBenchmark.h"
+#include "./SolverEngine.h"
+
+using namespace std;  // NOLINT
+
+// one entry of a performance baseline: the games that are played (length,
+// strategy, games and seed) and what playing them gave
+struct PerfCase {
+    int length_ = 0;
+    GuessStrategy strategy_ = GuessStrategy::Universe;
+    size_t games_ = 0;
+    unsigned int seed_ = 1;
+    double averageGuesses_ = 0;
+    size_t maxGuesses_ = 0;
+    size_t failures_ = 0;
+    // duration of all games and 99th percentile of the nextGuess calls
+    double seconds_ = 0;
+    uint64_t p99Ns_ = 0;
+
+    // returns the case as one line of json
+    string toJson() const;
+};
+
+// how much worse than the baseline a measurement may be
+// guesses are compared absolutely, times relatively with an absolute slack
+// below which differences are treated as noise
+struct PerfThresholds {
+    double averageGuesses_ = 0.02;
+    size_t maxGuesses_ = 0;
+    size_t failures_ = 0;
+    double time_ = 0.3;
+    double secondsSlack_ = 0.05;
+    uint64_t p99SlackNs_ = 200000;
+};
+
+// one compared value of a case
+struct PerfCheck {
+    string name_;
+    double baseline_;
+    double measured_;
+    // largest measured value that still passes
+    double limit_;
+
+    bool passed() const { return measured_ <= limit_; }
+};
+
+// plays the games of c with solver (which has to play c.length_ and should
+// be seeded with c.seed_) and returns c with the measured values
+PerfCase measurePerfCase(const PerfCase& c, NerdleSolverBase* solver);
+
+// compares every value of measured with baseline
+vector<PerfCheck> comparePerfCase(const PerfCase& baseline,
+    const PerfCase& measured, const PerfThresholds& thresholds);
+
+// returns a table of checks with one line per value, failed lines are
+// marked with the allowed limit
+string formatPerfChecks(const PerfCase& c, const vector<PerfCheck>& checks);
+
+// reads a baseline written by writePerfBaseline (a json array with one flat
+// object per case), returns false if text isnt one
+bool parsePerfBaseline(const string& text, vector<PerfCase>* cases);
+
+// returns cases as json array with one case per line
+string writePerfBaseline(const vector<PerfCase>& cases);
+
+#endif  // PERFREGRESSION_H_
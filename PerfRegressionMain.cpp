@@ -0,0 +1,68 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "./NerdleSolver.h"
+#include "./PerfRegression.h"
+
+// plays the games of every case of a baseline file and fails if guesses or
+// times got worse than the thresholds allow, with "update" the measured
+// values are written back to the file instead
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3 ||
+            (argc == 3 && std::string(argv[2]) != "update")) {
+        std::cerr << "Usage ./PerfRegressionMain <baseline.json> [update]"
+            << std::endl;
+        std::exit(1);
+    }
+    const std::string path = argv[1];
+    const bool update = argc == 3;
+    std::ifstream in(path);
+    std::stringstream text;
+    text << in.rdbuf();
+    std::vector<PerfCase> baseline;
+    if (!in || !parsePerfBaseline(text.str(), &baseline)) {
+        std::cerr << "Cannot read baseline " << path << std::endl;
+        std::exit(1);
+    }
+
+    std::vector<PerfCase> measured;
+    size_t failed = 0;
+    for (const PerfCase& c : baseline) {
+        if (!isSupportedLength(c.length_)) {
+            std::cerr << "Unsupported length " << c.length_ << std::endl;
+            std::exit(1);
+        }
+        // building the tables isnt part of the measured time
+        NerdleSolver solver(c.length_, c.strategy_);
+        solver.seed(c.seed_);
+        measured.push_back(measurePerfCase(c, &solver));
+        std::vector<PerfCheck> checks = comparePerfCase(c, measured.back(),
+            PerfThresholds());
+        for (const PerfCheck& check : checks)
+            failed += !check.passed();
+        std::cout << formatPerfChecks(c, checks) << std::flush;
+    }
+
+    if (update) {
+        std::ofstream out(path);
+        out << writePerfBaseline(measured);
+        if (!out) {
+            std::cerr << "Cannot write baseline " << path << std::endl;
+            std::exit(1);
+        }
+        std::cout << "Updated " << path << std::endl;
+        return 0;
+    }
+    if (failed > 0) {
+        std::cout << failed << " values are worse than the baseline allows"
+            << std::endl;
+        return 1;
+    }
+    std::cout << "All values within the baseline" << std::endl;
+}
@@ -0,0 +1,88 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "./NerdleSolver.h"
+#include "./PerfRegression.h"
+
+TEST(PerfRegression, baseline) {
+    PerfCase c;
+    c.length_ = 8;
+    c.strategy_ = GuessStrategy::Entropy;
+    c.games_ = 20;
+    c.seed_ = 3;
+    c.averageGuesses_ = 3.25;
+    c.maxGuesses_ = 4;
+    c.seconds_ = 0.5;
+    c.p99Ns_ = 123456789;
+    PerfCase other = c;
+    other.length_ = 10;
+    other.strategy_ = GuessStrategy::Universe;
+    other.failures_ = 2;
+
+    vector<PerfCase> read;
+    ASSERT_EQ(parsePerfBaseline(writePerfBaseline({c, other}), &read), true);
+    ASSERT_EQ(read.size(), 2u);
+    ASSERT_EQ(read[0].toJson(), c.toJson());
+    ASSERT_EQ(read[1].toJson(), other.toJson());
+    ASSERT_EQ(parsePerfBaseline("[]", &read), true);
+    ASSERT_EQ(read.size(), 0u);
+
+    // missing values, unknown strategies and broken json
+    ASSERT_EQ(parsePerfBaseline("[{\"length\": 8}]", &read), false);
+    string unknown = writePerfBaseline({c});
+    unknown.replace(unknown.find("entropy"), 7, "magic");
+    ASSERT_EQ(parsePerfBaseline(unknown, &read), false);
+    string cut = writePerfBaseline({c});
+    ASSERT_EQ(parsePerfBaseline(cut.substr(0, cut.size() / 2), &read), false);
+}
+
+TEST(PerfRegression, comparePerfCase) {
+    PerfCase base;
+    base.averageGuesses_ = 3.5;
+    base.maxGuesses_ = 5;
+    base.seconds_ = 2;
+    base.p99Ns_ = 10000000;
+    PerfThresholds thresholds;
+    for (const PerfCheck& check : comparePerfCase(base, base, thresholds))
+        ASSERT_EQ(check.passed(), true) << check.name_;
+
+    PerfCase worse = base;
+    worse.averageGuesses_ = 3.6;
+    worse.maxGuesses_ = 6;
+    worse.seconds_ = 3;
+    vector<PerfCheck> checks = comparePerfCase(base, worse, thresholds);
+    vector<string> failed;
+    for (const PerfCheck& check : checks) {
+        if (!check.passed())
+            failed.push_back(check.name_);
+    }
+    ASSERT_EQ(failed, vector<string>({"averageGuesses", "maxGuesses",
+        "seconds"}));
+    const string table = formatPerfChecks(base, checks);
+    ASSERT_NE(table.find("FAILED (+50.0%, limit 2.65)"), string::npos)
+        << table;
+
+    // times within the slack are noise
+    PerfCase tiny = base;
+    tiny.seconds_ = 0.01;
+    PerfCase noisy = tiny;
+    noisy.seconds_ = 0.05;
+    ASSERT_EQ(comparePerfCase(tiny, noisy, thresholds)[3].passed(), true);
+}
+
+TEST(PerfRegression, measurePerfCase) {
+    PerfCase c;
+    c.length_ = 8;
+    c.strategy_ = GuessStrategy::Universe;
+    c.games_ = 10;
+    NerdleSolver solver(c.length_, c.strategy_);
+    PerfCase measured = measurePerfCase(c, &solver);
+    ASSERT_EQ(measured.games_, 10u);
+    ASSERT_EQ(measured.failures_, 0u);
+    ASSERT_GE(measured.averageGuesses_, 1);
+    ASSERT_LE(measured.maxGuesses_, 6u);
+    ASSERT_GT(measured.p99Ns_, 0u);
+}
@@ -0,0 +1,53 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef RANDOMSTREAM_H_
+#define RANDOMSTREAM_H_
+
+#include <cstdint>
+
+using namespace std;  // NOLINT
+
+// counter based random numbers: the n-th number of a stream is a hash of its
+// key and n, so a stream can jump ahead for free and splits into any amount
+// of independent streams (e.g. one per thread or per task) without sharing
+// state, the same seed always gives the same numbers
+class RandomStream {
+ public:
+    // UniformRandomBitGenerator, so it works with <random> and <algorithm>
+    using result_type = uint64_t;
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return UINT64_MAX; }
+
+    // setup stream number stream of given seed
+    explicit RandomStream(const uint64_t seed = 0, const uint64_t stream = 0)
+            : key_(mix(mix(seed) + (stream + 1) * kGolden)) {}
+    // returns the next number
+    uint64_t operator()() { return mix(key_ + ++counter_ * kGolden); }
+    // returns the next number reduced to [0, n) (n > 0)
+    uint32_t below(const uint32_t n) {
+        return (operator()() >> 32) * n >> 32;
+    }
+    // skips the next n numbers
+    void discard(const uint64_t n) { counter_ += n; }
+    // returns stream number stream derived from this one, it doesnt depend
+    // on how many numbers were drawn from this one
+    RandomStream fork(const uint64_t stream) const {
+        return RandomStream(key_, stream);
+    }
+
+ private:
+    // odd 64 bit constant of the golden ratio (as in splitmix64)
+    static constexpr uint64_t kGolden = 0x9E3779B97F4A7C15ull;
+    uint64_t key_;
+    uint64_t counter_ = 0;
+
+    // finalizer of splitmix64, every bit of z changes half of the result
+    static constexpr uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+};
+
+#endif  // RANDOMSTREAM_H_
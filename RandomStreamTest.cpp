@@ -0,0 +1,49 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <gtest/gtest.h>
+#include <set>
+#include "./RandomStream.h"
+
+TEST(RandomStream, reproducible) {
+    RandomStream a(42, 3);
+    RandomStream b(42, 3);
+    RandomStream other(42, 4);
+    int same = 0;
+    for (int i = 0; i < 100; ++i) {
+        const uint64_t x = a();
+        ASSERT_EQ(x, b());
+        same += x == other();
+    }
+    ASSERT_EQ(same, 0);
+    ASSERT_NE(RandomStream(1)(), RandomStream(2)());
+}
+
+TEST(RandomStream, discard) {
+    RandomStream a(5);
+    RandomStream b(5);
+    for (int i = 0; i < 10; ++i)
+        a();
+    b.discard(10);
+    ASSERT_EQ(a(), b());
+}
+
+TEST(RandomStream, fork) {
+    // forks only depend on the key, not on what was drawn before
+    RandomStream a(9);
+    RandomStream child = a.fork(2);
+    a();
+    ASSERT_EQ(a.fork(2)(), child());
+    ASSERT_NE(a.fork(1)(), a.fork(2)());
+}
+
+TEST(RandomStream, below) {
+    RandomStream r(1);
+    set<uint32_t> seen;
+    for (int i = 0; i < 1000; ++i) {
+        const uint32_t x = r.below(7);
+        ASSERT_LT(x, 7u);
+        seen.insert(x);
+    }
+    ASSERT_EQ(seen.size(), 7u);
+}
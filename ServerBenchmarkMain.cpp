@@ -0,0 +1,83 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <unistd.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "./HeadlessBenchmark.h"
+#include "./NerdleSolver.h"
+#include "./SolverServer.h"
+
+// starts a SolverServer on a unix socket and lets clients play sampled games
+// against it at the same time, every client waits for each answer before it
+// sends the next request
+int main(int argc, char** argv) {
+    const auto usage = []() {
+        std::cerr << "Usage ./ServerBenchmarkMain <lengthOfExpressions> "
+            << "[random|universe|search|entropy|minimax|montecarlo] "
+            << "[games] [clients] [threads]"
+            << std::endl;
+        std::exit(1);
+    };
+    if (argc < 2 || argc > 6)
+        usage();
+    const int length = std::atoi(argv[1]);
+    if (!isSupportedLength(length)) {
+        std::cerr << "Unsupported length " << argv[1] << std::endl;
+        std::exit(1);
+    }
+    GuessStrategy strategy = GuessStrategy::Universe;
+    if (argc >= 3 && !parseStrategy(argv[2], &strategy))
+        usage();
+    const size_t games = argc >= 4 ? std::atoi(argv[3]) : 1000;
+    const size_t clients = argc >= 5 ? std::max(1, std::atoi(argv[4])) : 16;
+    const unsigned int threads = argc == 6 ? std::atoi(argv[5]) : 0;
+
+    NerdleSolver solver(length, strategy);
+    SolverServer server(&solver, threads);
+    const std::string path = "/tmp/nerdle-server-" +
+        std::to_string(getpid()) + ".sock";
+    if (!server.listen(path)) {
+        std::cerr << "Cannot listen on " << path << std::endl;
+        std::exit(1);
+    }
+    const std::vector<std::string> answers = sampleAnswers(length, games, 1);
+    std::vector<BenchmarkResult> results(clients);
+    std::vector<std::thread> threadsOfClients;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t c = 0; c < clients; ++c) {
+        threadsOfClients.emplace_back([&, c]() {
+            std::vector<std::string> own;
+            for (size_t i = c; i < answers.size(); i += clients)
+                own.push_back(answers[i]);
+            SolverClient client(path);
+            results[c] = runHeadlessBenchmark(&client, own);
+        });
+    }
+    for (std::thread& t : threadsOfClients)
+        t.join();
+    const double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    server.stop();
+
+    BenchmarkResult total;
+    total.length_ = length;
+    total.seconds_ = seconds;
+    total.guessCounts_.resize(7, 0);
+    for (const BenchmarkResult& r : results) {
+        total.games_ += r.games_;
+        total.failures_ += r.failures_;
+        for (size_t g = 0; g < r.guessCounts_.size(); ++g)
+            total.guessCounts_[g] += r.guessCounts_[g];
+        total.latencies_.insert(total.latencies_.end(), r.latencies_.begin(),
+            r.latencies_.end());
+    }
+    std::cout << total.toJson() << std::endl;
+    std::cout << "{\"clients\": " << clients << ", \"requests\": "
+        << server.requests() << ", \"requestsPerSecond\": "
+        << server.requests() / seconds << "}" << std::endl;
+}
@@ -0,0 +1,34 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include "./SolverCounters.h"
+
+void SolverCounters::add(const SolverCounters& other) {
+    randomRetries_ += other.randomRetries_;
+    maxTurnRetries_ = max(maxTurnRetries_, other.maxTurnRetries_);
+    syntaxRejections_ += other.syntaxRejections_;
+    valueRejections_ += other.valueRejections_;
+    addWPExhausted_ += other.addWPExhausted_;
+    guessRestExhausted_ += other.guessRestExhausted_;
+    guessRestEmpty_ += other.guessRestEmpty_;
+    updates_ += other.updates_;
+    updateNanos_ += other.updateNanos_;
+}
+
+string SolverCounters::toJson() const {
+    ostringstream out;
+    out << "{\"enabled\": " << (enabled() ? "true" : "false")
+        << ", \"randomRetries\": " << randomRetries_
+        << ", \"maxTurnRetries\": " << maxTurnRetries_
+        << ", \"syntaxRejections\": " << syntaxRejections_
+        << ", \"valueRejections\": " << valueRejections_
+        << ", \"addWPExhausted\": " << addWPExhausted_
+        << ", \"guessRestExhausted\": " << guessRestExhausted_
+        << ", \"guessRestEmpty\": " << guessRestEmpty_
+        << ", \"updates\": " << updates_
+        << ", \"updateNanos\": " << updateNanos_ << "}";
+    return out.str();
+}
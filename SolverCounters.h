@@ -0,0 +1,50 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef SOLVERCOUNTERS_H_
+#define SOLVERCOUNTERS_H_
+
+#include <cstdint>
+#include <string>
+
+using namespace std;  // NOLINT
+
+// counts what the solver spends its time on, the counting is only compiled
+// in with -DNERDLE_COUNTERS (make COUNTERS=1), otherwise all stay 0
+#ifdef NERDLE_COUNTERS
+#define NERDLE_COUNT(counter, n) ((counter) += (n))
+#else
+#define NERDLE_COUNT(counter, n) ((void)0)
+#endif
+
+struct SolverCounters {
+    // extra rounds of the random guessing loop and the most in one turn
+    uint64_t randomRetries_ = 0;
+    uint64_t maxTurnRetries_ = 0;
+    // random equations rejected for their syntax or their value
+    uint64_t syntaxRejections_ = 0;
+    uint64_t valueRejections_ = 0;
+    // times getEqAddWP and getEqGuessRest ran out of tries
+    uint64_t addWPExhausted_ = 0;
+    uint64_t guessRestExhausted_ = 0;
+    // times getEqGuessRest found a position without usable symbol
+    uint64_t guessRestEmpty_ = 0;
+    // calls of Board::update and the time they took
+    uint64_t updates_ = 0;
+    uint64_t updateNanos_ = 0;
+
+    // adds all counters of other
+    void add(const SolverCounters& other);
+    // returns the counters as one line of json
+    string toJson() const;
+    // returns true if the counting is compiled in
+    static constexpr bool enabled() {
+#ifdef NERDLE_COUNTERS
+        return true;
+#else
+        return false;
+#endif
+    }
+};
+
+#endif  // SOLVERCOUNTERS_H_
@@ -0,0 +1,79 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <ctime>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include "./SolverEngine.h"
+
+namespace {
+// every strategy with its name
+const pair<GuessStrategy, const char*> kStrategyNames[] = {
+    {GuessStrategy::Random, "random"}, {GuessStrategy::Universe, "universe"},
+    {GuessStrategy::Search, "search"}, {GuessStrategy::Entropy, "entropy"},
+    {GuessStrategy::Minimax, "minimax"},
+    {GuessStrategy::MonteCarlo, "montecarlo"}};
+}  // namespace
+
+string strategyName(const GuessStrategy strategy) {
+    for (const auto& [s, name] : kStrategyNames) {
+        if (s == strategy)
+            return name;
+    }
+    return "";
+}
+
+bool parseStrategy(const string& name, GuessStrategy* strategy) {
+    for (const auto& [s, n] : kStrategyNames) {
+        if (name == n) {
+            *strategy = s;
+            return true;
+        }
+    }
+    return false;
+}
+
+SolverEngine::SolverEngine(const int length, const GuessStrategy strategy,
+        shared_ptr<const OpeningBook> book)
+        : length_(length), strategy_(strategy), book_(book) {
+    if (strategy_ == GuessStrategy::Universe ||
+            strategy_ == GuessStrategy::Entropy ||
+            strategy_ == GuessStrategy::Minimax ||
+            strategy_ == GuessStrategy::MonteCarlo)
+        universe_ = EquationUniverse::get(length);
+    start_.board_ = Board(length_);
+    start_.seed_ = time(NULL);
+    start_.board_.seed(start_.seed_);
+    if (universe_)
+        start_.board_.trackCandidates(universe_);
+}
+
+shared_ptr<const SolverEngine> SolverEngine::get(const int length,
+        const GuessStrategy strategy) {
+    static mutex lock;
+    static map<pair<int, GuessStrategy>, weak_ptr<const SolverEngine>> engines;
+    lock_guard<mutex> guard(lock);
+    weak_ptr<const SolverEngine>& cached = engines[{length, strategy}];
+    shared_ptr<const SolverEngine> engine = cached.lock();
+    if (!engine) {
+        engine = make_shared<const SolverEngine>(length, strategy);
+        cached = engine;
+    }
+    return engine;
+}
+
+shared_ptr<const SolverEngine> SolverEngine::withBook(
+        shared_ptr<const OpeningBook> book) const {
+    auto engine = make_shared<SolverEngine>(*this);
+    engine->book_ = book;
+    return engine;
+}
+
+WorkStealingPool* SolverEngine::pool() const {
+    call_once(pool_->started_,
+        [this]() { pool_->pool_ = make_unique<WorkStealingPool>(); });
+    return pool_->pool_.get();
+}
@@ -0,0 +1,105 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef SOLVERENGINE_H_
+#define SOLVERENGINE_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include "./Board.h"
+#include "./EquationUniverse.h"
+#include "./OpeningBook.h"
+#include "./SolverCounters.h"
+#include "./WorkStealingPool.h"
+
+using namespace std;  // NOLINT
+
+// how the solver comes up with guesses after the first one
+// Random: fills unknown positions randomly until a valid equation is found
+// Universe: picks the first consistent equation of the EquationUniverse
+// Search: depth first search for the first consistent equation
+// Entropy: picks the equation whose hints are expected to tell the most
+// about the remaining consistent equations
+// Minimax: picks the equation that leaves the fewest consistent equations in
+// the worst case
+// MonteCarlo: picks the equation with the fewest guesses in simulated games
+// against sampled answers
+enum class GuessStrategy {
+    Random, Universe, Search, Entropy, Minimax, MonteCarlo
+};
+
+// returns the lowercase name of strategy as the command line takes it
+string strategyName(const GuessStrategy strategy);
+// writes the strategy called name to strategy, returns false if there is none
+bool parseStrategy(const string& name, GuessStrategy* strategy);
+
+// everything the solver keeps track of for one game
+struct GameContext {
+    // keeps track of the Game
+    Board board_;
+    // saves the last size of gamestate (needed for new game detection)
+    size_t lastGSSize_ = 0;
+    // counters of all boards before board_
+    SolverCounters counters_;
+    // seed of the random guesses and the simulated games, the same seed
+    // always gives the same guesses
+    uint64_t seed_ = 0;
+
+    // returns everything counted for this context so far
+    SolverCounters counters() const {
+        SolverCounters c = counters_;
+        c.add(board_.counters());
+        return c;
+    }
+};
+
+// read-only data of all games with one equation length and strategy: the
+// equation universe, the opening book and the context of a fresh game
+// an engine never changes after construction (apart from starting its
+// pool), so any amount of solvers and threads can share one
+class SolverEngine {
+ public:
+    SolverEngine(const int length, const GuessStrategy strategy,
+        shared_ptr<const OpeningBook> book = nullptr);
+    // returns the engine for given length and strategy (without book), it is
+    // built on first request and shared as long as anybody uses it
+    static shared_ptr<const SolverEngine> get(const int length,
+        const GuessStrategy strategy);
+    // returns an engine with the same data as this one but given book
+    shared_ptr<const SolverEngine> withBook(
+        shared_ptr<const OpeningBook> book) const;
+    int length() const { return length_; }
+    GuessStrategy strategy() const { return strategy_; }
+    // all valid equations (only set for GuessStrategy::Universe,
+    // GuessStrategy::Entropy, GuessStrategy::Minimax and
+    // GuessStrategy::MonteCarlo)
+    const shared_ptr<const EquationUniverse>& universe() const {
+        return universe_;
+    }
+    // first guesses of the game (may be null)
+    const shared_ptr<const OpeningBook>& book() const { return book_; }
+    // context before the first guess, starting a game is a copy of it
+    const GameContext& start() const { return start_; }
+    // threads of the scorers of all solvers of this engine and of the
+    // engines made from it by withBook, started on first request
+    // the pool runs one job at a time, so solvers of one engine that score
+    // guesses at the same time wait for each other (every job already uses
+    // all cores), use a BatchSolver to answer many games in parallel
+    WorkStealingPool* pool() const;
+
+ private:
+    struct SharedPool {
+        once_flag started_;
+        unique_ptr<WorkStealingPool> pool_;
+    };
+
+    int length_;
+    GuessStrategy strategy_;
+    shared_ptr<const EquationUniverse> universe_;
+    shared_ptr<const OpeningBook> book_;
+    GameContext start_;
+    shared_ptr<SharedPool> pool_ = make_shared<SharedPool>();
+};
+
+#endif  // SOLVERENGINE_H_
@@ -0,0 +1,64 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "./HeadlessBenchmark.h"
+#include "./NerdleSolver.h"
+#include "./SolverEngine.h"
+
+TEST(SolverEngine, get) {
+    shared_ptr<const SolverEngine> engine =
+        SolverEngine::get(8, GuessStrategy::Universe);
+    ASSERT_EQ(engine->length(), 8);
+    ASSERT_EQ(engine->universe()->size(), 18290u);
+    ASSERT_EQ(engine->start().board_.candidateCount(), 18290u);
+    ASSERT_EQ(SolverEngine::get(8, GuessStrategy::Universe), engine);
+    ASSERT_NE(SolverEngine::get(8, GuessStrategy::Search), engine);
+    ASSERT_EQ(SolverEngine::get(8, GuessStrategy::Search)->universe(),
+        nullptr);
+
+    // solvers share the engine until one of them gets a book
+    NerdleSolver a(8), b(8);
+    ASSERT_EQ(a.engine(), engine);
+    ASSERT_EQ(b.engine(), engine);
+    WorkStealingPool pool(1);
+    GuessScorer scorer(8, &pool);
+    ASSERT_EQ(b.useOpeningBook(make_shared<OpeningBook>(OpeningBook::build(
+        engine->universe()->equations(), "1+7*9=64", 1, &scorer, 20))), true);
+    ASSERT_NE(b.engine(), engine);
+    ASSERT_EQ(b.engine()->universe(), engine->universe());
+    ASSERT_EQ(engine->book(), nullptr);
+    // one pool for all solvers of the engine
+    ASSERT_EQ(b.engine()->pool(), engine->pool());
+    ASSERT_EQ(engine->pool(), engine->pool());
+}
+
+TEST(SolverEngine, sharedBetweenThreads) {
+    vector<string> answers = sampleAnswers(8, 50, 3);
+    // entropy solvers share the pool of the engine too
+    for (const GuessStrategy strategy :
+            {GuessStrategy::Universe, GuessStrategy::Entropy}) {
+        shared_ptr<const SolverEngine> engine = SolverEngine::get(8, strategy);
+        NerdleSolver single(engine);
+        single.seed(3);
+        const vector<size_t> expected =
+            runHeadlessBenchmark(&single, answers).guessCounts_;
+        vector<vector<size_t>> counts(4);
+        vector<thread> threads;
+        for (size_t t = 0; t < counts.size(); ++t) {
+            threads.emplace_back([&, t]() {
+                NerdleSolver solver(engine);
+                solver.seed(3);
+                counts[t] = runHeadlessBenchmark(&solver, answers).guessCounts_;
+            });
+        }
+        for (thread& t : threads)
+            t.join();
+        for (const vector<size_t>& c : counts)
+            ASSERT_EQ(c, expected);
+    }
+}
@@ -0,0 +1,331 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "./EquationValidator.h"
+#include "./NerdleSymbols.h"
+#include "./SolverServer.h"
+
+SolverServer::SolverServer(const NerdleSolver* solver, unsigned int threads,
+        size_t maxBatch)
+        : solver_(solver), batch_(solver, threads),
+        maxBatch_(max<size_t>(1, maxBatch)) {
+    dispatcher_ = thread([this]() { dispatch(); });
+}
+
+SolverServer::~SolverServer() {
+    stop();
+    {
+        lock_guard<mutex> guard(lock_);
+        stopping_ = true;
+    }
+    queued_.notify_all();
+    dispatcher_.join();
+}
+
+void SolverServer::serve(istream& in, ostream& out) {
+    auto connection = make_shared<Connection>();
+    connection->write_ = [&out](const string& line) {
+        out << line << '\n';
+        out.flush();
+    };
+    string line;
+    while (getline(in, line)) {
+        if (!line.empty())
+            submit(line, connection);
+    }
+    drain(connection);
+}
+
+bool SolverServer::listen(const string& path) {
+    sockaddr_un address;
+    if (path.size() >= sizeof(address.sun_path))
+        return false;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    listenFd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd_ < 0)
+        return false;
+    unlink(path.c_str());
+    if (bind(listenFd_, reinterpret_cast<sockaddr*>(&address),
+            sizeof(address)) != 0 || ::listen(listenFd_, 128) != 0) {
+        close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+    path_ = path;
+    acceptor_ = thread([this]() { acceptLoop(); });
+    return true;
+}
+
+void SolverServer::wait() {
+    unique_lock<mutex> guard(connectionsLock_);
+    stopped_.wait(guard, [this]() { return listenFd_ < 0; });
+}
+
+void SolverServer::stop() {
+    {
+        lock_guard<mutex> guard(connectionsLock_);
+        if (listenFd_ >= 0) {
+            // wakes up accept and every read
+            shutdown(listenFd_, SHUT_RDWR);
+            for (int fd : connectionFds_)
+                shutdown(fd, SHUT_RDWR);
+        }
+    }
+    if (acceptor_.joinable())
+        acceptor_.join();
+    for (thread& t : connections_)
+        t.join();
+    connections_.clear();
+    lock_guard<mutex> guard(connectionsLock_);
+    finished_.clear();
+    if (listenFd_ >= 0) {
+        close(listenFd_);
+        unlink(path_.c_str());
+        listenFd_ = -1;
+    }
+    stopped_.notify_all();
+}
+
+bool SolverServer::parseRequest(const string& line, const int length,
+        string* id, NerdleGameState* state) {
+    istringstream in(line);
+    if (!(in >> *id))
+        return false;
+    state->clear();
+    string turn;
+    while (in >> turn) {
+        const size_t colon = turn.find(':');
+        if (colon != static_cast<size_t>(length) ||
+                turn.size() != 2 * static_cast<size_t>(length) + 1)
+            return false;
+        NerdleStatusRow row;
+        for (int i = 0; i < length; ++i) {
+            // a char outside of the alphabet would index out of bounds later
+            if (symbolIndex(turn[i]) < 0)
+                return false;
+            CharacterAndStatus cas;
+            cas.character_ = turn[i];
+            switch (turn[length + 1 + i]) {
+                case 'G':
+                    cas.status_ = NerdleStatus::Correct;
+                    break;
+                case 'M':
+                    cas.status_ = NerdleStatus::WrongPosition;
+                    break;
+                case 'B':
+                    cas.status_ = NerdleStatus::Wrong;
+                    break;
+                default:
+                    return false;
+            }
+            row.push_back(cas);
+        }
+        state->push_back(row);
+    }
+    return true;
+}
+
+string SolverServer::formatRequest(const string& id,
+        const NerdleGameState& state) {
+    string line = id;
+    for (const NerdleStatusRow& row : state) {
+        line.push_back(' ');
+        for (const CharacterAndStatus& cas : row)
+            line.push_back(cas.character_);
+        line.push_back(':');
+        for (const CharacterAndStatus& cas : row) {
+            line.push_back(cas.status_ == NerdleStatus::Correct ? 'G' :
+                cas.status_ == NerdleStatus::WrongPosition ? 'M' : 'B');
+        }
+    }
+    return line;
+}
+
+void SolverServer::submit(const string& line,
+        const shared_ptr<Connection>& connection) {
+    {
+        lock_guard<mutex> guard(connection->lock_);
+        ++connection->pending_;
+    }
+    {
+        lock_guard<mutex> guard(lock_);
+        queue_.push_back({line, connection});
+    }
+    queued_.notify_one();
+}
+
+void SolverServer::drain(const shared_ptr<Connection>& connection) {
+    unique_lock<mutex> guard(connection->lock_);
+    connection->done_.wait(guard,
+        [&]() { return connection->pending_ == 0; });
+}
+
+void SolverServer::dispatch() {
+    vector<Request> batch;
+    while (true) {
+        {
+            unique_lock<mutex> guard(lock_);
+            queued_.wait(guard,
+                [this]() { return stopping_ || !queue_.empty(); });
+            if (queue_.empty())
+                return;
+            // everything that arrived while the last batch was solved
+            while (!queue_.empty() && batch.size() < maxBatch_) {
+                batch.push_back(move(queue_.front()));
+                queue_.pop_front();
+            }
+        }
+        answer(&batch);
+        batch.clear();
+    }
+}
+
+void SolverServer::answer(vector<Request>* batch) {
+    const size_t n = batch->size();
+    vector<string> ids(n);
+    vector<bool> valid(n);
+    // only the requests that parse are solved, the contexts of their games
+    // are built on the threads of the batch solver
+    vector<NerdleGameState> states;
+    states.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        NerdleGameState state;
+        valid[i] = parseRequest((*batch)[i].line_, solver_->length(), &ids[i],
+            &state);
+        if (valid[i])
+            states.push_back(move(state));
+    }
+    vector<string> guesses(states.size());
+    batch_.nextGuesses(states.data(), states.size(), guesses.data());
+    // counted before the answers go out, so a client that got all its answers
+    // sees them counted
+    requests_ += n;
+    size_t solved = 0;
+    for (size_t i = 0; i < n; ++i) {
+        Connection& c = *(*batch)[i].connection_;
+        const string line = valid[i] ? ids[i] + " " + guesses[solved++] :
+            ids[i] + " error malformed request";
+        lock_guard<mutex> guard(c.lock_);
+        c.write_(line);
+        if (--c.pending_ == 0)
+            c.done_.notify_all();
+    }
+}
+
+void SolverServer::acceptLoop() {
+    while (true) {
+        const int fd = accept(listenFd_, nullptr, nullptr);
+        if (fd < 0)
+            return;
+        lock_guard<mutex> guard(connectionsLock_);
+        // so a long running server doesnt keep a thread per past client
+        reapConnections();
+        connectionFds_.push_back(fd);
+        connections_.emplace_back([this, fd]() { readLoop(fd); });
+    }
+}
+
+void SolverServer::reapConnections() {
+    for (const thread::id id : finished_) {
+        auto t = find_if(connections_.begin(), connections_.end(),
+            [id](const thread& c) { return c.get_id() == id; });
+        // the reader doesnt touch the server after marking itself finished
+        t->join();
+        connections_.erase(t);
+    }
+    finished_.clear();
+}
+
+void SolverServer::readLoop(const int fd) {
+    auto connection = make_shared<Connection>();
+    connection->write_ = [fd](const string& line) {
+        string data = line + "\n";
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t k = send(fd, data.data() + sent, data.size() - sent,
+                MSG_NOSIGNAL);
+            if (k <= 0)
+                return;
+            sent += k;
+        }
+    };
+    string buffer;
+    char chunk[4096];
+    ssize_t k;
+    while ((k = read(fd, chunk, sizeof(chunk))) > 0) {
+        buffer.append(chunk, k);
+        size_t start = 0;
+        for (size_t end = buffer.find('\n'); end != string::npos;
+                end = buffer.find('\n', start)) {
+            if (end > start)
+                submit(buffer.substr(start, end - start), connection);
+            start = end + 1;
+        }
+        buffer.erase(0, start);
+    }
+    drain(connection);
+    lock_guard<mutex> guard(connectionsLock_);
+    connectionFds_.erase(find(connectionFds_.begin(), connectionFds_.end(),
+        fd));
+    close(fd);
+    finished_.push_back(this_thread::get_id());
+}
+
+SolverClient::SolverClient(const string& path) {
+    sockaddr_un address;
+    if (path.size() >= sizeof(address.sun_path))
+        return;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd_ >= 0 && connect(fd_, reinterpret_cast<sockaddr*>(&address),
+            sizeof(address)) != 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+SolverClient::~SolverClient() {
+    if (fd_ >= 0)
+        close(fd_);
+}
+
+string SolverClient::nextGuess(const NerdleGameState& gameState) {
+    if (fd_ < 0)
+        return "";
+    const string id = to_string(next_++);
+    const string request = SolverServer::formatRequest(id, gameState) + "\n";
+    size_t sent = 0;
+    while (sent < request.size()) {
+        ssize_t k = send(fd_, request.data() + sent, request.size() - sent,
+            MSG_NOSIGNAL);
+        if (k <= 0)
+            return "";
+        sent += k;
+    }
+    size_t end;
+    while ((end = buffer_.find('\n')) == string::npos) {
+        char chunk[4096];
+        ssize_t k = read(fd_, chunk, sizeof(chunk));
+        if (k <= 0)
+            return "";
+        buffer_.append(chunk, k);
+    }
+    const string line = buffer_.substr(0, end);
+    buffer_.erase(0, end + 1);
+    // "<id> <guess>"
+    if (line.compare(0, id.size() + 1, id + " ") != 0)
+        return "";
+    return line.substr(id.size() + 1);
+}
@@ -0,0 +1,130 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef SOLVERSERVER_H_
+#define SOLVERSERVER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "./BatchSolver.h"
+#include "./NerdleBenchmark.h"
+#include "./NerdleSolver.h"
+
+using namespace std;  // NOLINT
+
+// answers game states sent as text lines with the next guess
+// a request is "<id>" followed by one "<guess>:<hints>" per row so far, where
+// hints has one letter per symbol: G (correct), M (wrong position) and B
+// (wrong), e.g. "7 1+7*9=64:BBGMBBMB"
+// the answer is "<id> <guess>" or "<id> error <reason>"
+// requests of all connections are collected in one queue and answered in
+// batches by a BatchSolver, so one connection can send many requests without
+// waiting for the answers (answers of one connection keep the order)
+class SolverServer {
+ public:
+    // solver decides the guesses and has to outlive the server, threads as in
+    // WorkStealingPool, a batch has at most maxBatch requests
+    explicit SolverServer(const NerdleSolver* solver,
+        unsigned int threads = 0, size_t maxBatch = 256);
+    ~SolverServer();
+    SolverServer(const SolverServer&) = delete;
+    SolverServer& operator=(const SolverServer&) = delete;
+    // answers every line of in on out and returns when in has ended and all
+    // answers are written
+    void serve(istream& in, ostream& out);
+    // accepts connections on a unix socket at path (in background threads)
+    // returns false if the socket cant be opened
+    bool listen(const string& path);
+    // blocks until stop is called
+    void wait();
+    // closes the socket and all connections
+    void stop();
+    // answered requests so far
+    uint64_t requests() const { return requests_; }
+
+    // reads a request line, returns false if it isnt one
+    static bool parseRequest(const string& line, const int length, string* id,
+        NerdleGameState* state);
+    // returns the request line for id and state
+    static string formatRequest(const string& id,
+        const NerdleGameState& state);
+
+ private:
+    // where the answers of one client go
+    struct Connection {
+        function<void(const string&)> write_;
+        mutex lock_;
+        condition_variable done_;
+        // requests without answer
+        size_t pending_ = 0;
+    };
+    struct Request {
+        string line_;
+        shared_ptr<Connection> connection_;
+    };
+
+    const NerdleSolver* solver_;
+    BatchSolver batch_;
+    size_t maxBatch_;
+    mutex lock_;
+    condition_variable queued_;
+    deque<Request> queue_;
+    bool stopping_ = false;
+    thread dispatcher_;
+    atomic<uint64_t> requests_{0};
+    // socket mode
+    int listenFd_ = -1;
+    string path_;
+    thread acceptor_;
+    mutex connectionsLock_;
+    vector<int> connectionFds_;
+    vector<thread> connections_;
+    // readers that have returned but arent joined yet
+    vector<thread::id> finished_;
+    condition_variable stopped_;
+
+    // queues line as request of connection
+    void submit(const string& line, const shared_ptr<Connection>& connection);
+    // waits until connection has all its answers
+    void drain(const shared_ptr<Connection>& connection);
+    // takes batches from the queue and answers them until the server stops
+    void dispatch();
+    // solves all requests of batch and writes their answers
+    void answer(vector<Request>* batch);
+    // accepts connections until the socket is closed
+    void acceptLoop();
+    // joins the finished readers (connectionsLock_ has to be held)
+    void reapConnections();
+    // reads requests of one socket connection until it is closed
+    void readLoop(const int fd);
+};
+
+// solver that asks a SolverServer listening on a unix socket for every guess
+class SolverClient : public NerdleSolverBase {
+ public:
+    // connects to the socket at path
+    explicit SolverClient(const string& path);
+    ~SolverClient();
+    SolverClient(const SolverClient&) = delete;
+    SolverClient& operator=(const SolverClient&) = delete;
+    bool connected() const { return fd_ >= 0; }
+    // returns the answer of the server or "" if there is none
+    string nextGuess(const NerdleGameState& gameState) override;
+
+ private:
+    int fd_ = -1;
+    // received data that doesnt end a line yet
+    string buffer_;
+    // id of the next request
+    uint64_t next_ = 0;
+};
+
+#endif  // SOLVERSERVER_H_
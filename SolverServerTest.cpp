@@ -0,0 +1,82 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "./HeadlessBenchmark.h"
+#include "./NerdleSolver.h"
+#include "./SolverServer.h"
+
+TEST(SolverServer, parseRequest) {
+    NerdleGameState state = {hintRow("1+7*9=64", "12+35=47"),
+        hintRow("12+35=47", "12+35=47")};
+    const string line = SolverServer::formatRequest("7", state);
+    ASSERT_EQ(line, "7 1+7*9=64:GMMBBGBM 12+35=47:GGGGGGGG");
+    string id;
+    NerdleGameState parsed;
+    ASSERT_TRUE(SolverServer::parseRequest(line, 8, &id, &parsed));
+    ASSERT_EQ(id, "7");
+    ASSERT_EQ(SolverServer::formatRequest(id, parsed), line);
+    ASSERT_TRUE(SolverServer::parseRequest("8", 8, &id, &parsed));
+    ASSERT_TRUE(parsed.empty());
+    ASSERT_FALSE(SolverServer::parseRequest("9 1+7*9=64:GMB", 8, &id,
+        &parsed));
+    ASSERT_FALSE(SolverServer::parseRequest("9 1+7*9=64:GMBBBGBX", 8, &id,
+        &parsed));
+    ASSERT_FALSE(SolverServer::parseRequest("9 abcdefgh:GBBBBBBB", 8, &id,
+        &parsed));
+    ASSERT_FALSE(SolverServer::parseRequest("", 8, &id, &parsed));
+}
+
+TEST(SolverServer, serve) {
+    NerdleSolver solver(8, GuessStrategy::Search);
+    const string answer = "12+35=47";
+    // the answers have to be the ones of a solver playing the game itself
+    NerdleSolver reference(8, GuessStrategy::Search);
+    NerdleGameState state;
+    ostringstream requests, expected;
+    for (int turn = 0; turn < 3; ++turn) {
+        const string guess = reference.nextGuess(state);
+        requests << SolverServer::formatRequest(to_string(turn), state)
+            << '\n';
+        expected << turn << ' ' << guess << '\n';
+        state.push_back(hintRow(guess, answer));
+    }
+    requests << "x y\n";
+    expected << "x error malformed request\n";
+    SolverServer server(&solver, 2, 2);
+    istringstream in(requests.str());
+    ostringstream out;
+    server.serve(in, out);
+    ASSERT_EQ(out.str(), expected.str());
+    ASSERT_EQ(server.requests(), 4u);
+}
+
+TEST(SolverServer, socket) {
+    NerdleSolver solver(8, GuessStrategy::Universe);
+    vector<string> answers = sampleAnswers(8, 40, 2);
+    NerdleSolver local(8, GuessStrategy::Universe);
+    const BenchmarkResult expected = runHeadlessBenchmark(&local, answers);
+
+    SolverServer server(&solver, 2);
+    const string path = "/tmp/nerdle-test-" + to_string(getpid()) + ".sock";
+    ASSERT_TRUE(server.listen(path));
+    vector<BenchmarkResult> results(3);
+    vector<thread> clients;
+    for (size_t c = 0; c < results.size(); ++c) {
+        clients.emplace_back([&, c]() {
+            SolverClient client(path);
+            results[c] = runHeadlessBenchmark(&client, answers);
+        });
+    }
+    for (thread& t : clients)
+        t.join();
+    server.stop();
+    for (const BenchmarkResult& r : results)
+        ASSERT_EQ(r.guessCounts_, expected.guessCounts_);
+    ASSERT_FALSE(SolverClient(path).connected());
+}
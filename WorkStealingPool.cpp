@@ -0,0 +1,101 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "./WorkStealingPool.h"
+
+WorkStealingPool::WorkStealingPool(unsigned int threads) : pending_(0) {
+    if (threads == 0)
+        threads = max(1u, thread::hardware_concurrency());
+    for (unsigned int i = 0; i < threads; ++i)
+        queues_.push_back(make_unique<Queue>());
+    for (unsigned int i = 1; i < threads; ++i)
+        workers_.emplace_back(&WorkStealingPool::loop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        lock_guard<mutex> guard(lock_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (thread& t : workers_)
+        t.join();
+}
+
+void WorkStealingPool::run(const size_t n,
+        const function<void(size_t, unsigned int)>& job) {
+    if (n == 0)
+        return;
+    lock_guard<mutex> runGuard(runLock_);
+    const size_t threads = queues_.size();
+    // a few chunks per thread leave something to steal
+    chunkSize_ = max<size_t>(1, n / (threads * 8));
+    const size_t chunks = (n + chunkSize_ - 1) / chunkSize_;
+    job_ = &job;
+    size_ = n;
+    pending_ = chunks;
+    for (size_t t = 0; t < threads; ++t) {
+        lock_guard<mutex> guard(queues_[t]->lock_);
+        for (size_t c = chunks * t / threads; c < chunks * (t + 1) / threads;
+                ++c)
+            queues_[t]->chunks_.push_back(c);
+    }
+    {
+        lock_guard<mutex> guard(lock_);
+        ++generation_;
+    }
+    wake_.notify_all();
+    work(0);
+    unique_lock<mutex> guard(lock_);
+    done_.wait(guard, [this]() { return pending_ == 0; });
+}
+
+void WorkStealingPool::loop(const unsigned int worker) {
+    uint64_t seen = 0;
+    while (true) {
+        {
+            unique_lock<mutex> guard(lock_);
+            wake_.wait(guard, [&]() { return stop_ || generation_ != seen; });
+            if (stop_)
+                return;
+            seen = generation_;
+        }
+        work(worker);
+    }
+}
+
+void WorkStealingPool::work(const unsigned int worker) {
+    size_t chunk;
+    while (take(worker, &chunk)) {
+        const size_t end = min(size_, (chunk + 1) * chunkSize_);
+        for (size_t i = chunk * chunkSize_; i < end; ++i)
+            (*job_)(i, worker);
+        if (--pending_ == 0) {
+            lock_guard<mutex> guard(lock_);
+            done_.notify_all();
+        }
+    }
+}
+
+bool WorkStealingPool::take(const unsigned int worker, size_t* chunk) {
+    const size_t threads = queues_.size();
+    for (size_t k = 0; k < threads; ++k) {
+        Queue& q = *queues_[(worker + k) % threads];
+        lock_guard<mutex> guard(q.lock_);
+        if (q.chunks_.empty())
+            continue;
+        if (k == 0) {
+            *chunk = q.chunks_.front();
+            q.chunks_.pop_front();
+        } else {
+            *chunk = q.chunks_.back();
+            q.chunks_.pop_back();
+        }
+        return true;
+    }
+    return false;
+}
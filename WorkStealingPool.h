@@ -0,0 +1,67 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#ifndef WORKSTEALINGPOOL_H_
+#define WORKSTEALINGPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;  // NOLINT
+
+// fixed set of threads that work on the indices of one job at a time
+// every thread starts with its own block of indices and steals from the end
+// of the other blocks once its own is done, so uneven jobs stay balanced
+class WorkStealingPool {
+ public:
+    // start pool with given amount of threads (0 means one per core)
+    // the thread calling run counts as one of them
+    explicit WorkStealingPool(unsigned int threads = 0);
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    // calls job(i, worker) for every i from 0 to n - 1 and returns when all
+    // calls are done, worker is the index (0 to threads() - 1) of the thread
+    // doing the call, so jobs can keep scratch memory per thread
+    void run(const size_t n, const function<void(size_t, unsigned int)>& job);
+    unsigned int threads() const { return queues_.size(); }
+
+ private:
+    // chunks of indices that still have to be done by one thread
+    struct Queue {
+        mutex lock_;
+        deque<size_t> chunks_;
+    };
+    vector<unique_ptr<Queue>> queues_;
+    vector<thread> workers_;
+    // current job, split into chunks of chunkSize_ indices
+    const function<void(size_t, unsigned int)>* job_ = nullptr;
+    size_t size_ = 0;
+    size_t chunkSize_ = 1;
+    atomic<size_t> pending_;
+    // wakes the workers for a new job (generation_ changes) or stop_
+    mutex lock_;
+    condition_variable wake_;
+    condition_variable done_;
+    uint64_t generation_ = 0;
+    bool stop_ = false;
+    // only one job can run at a time
+    mutex runLock_;
+
+    // waits for jobs until the pool is destroyed
+    void loop(const unsigned int worker);
+    // works on chunks until no queue has any left
+    void work(const unsigned int worker);
+    // takes a chunk from the front of the own queue or steals one from the
+    // back of another queue, returns false if all are empty
+    bool take(const unsigned int worker, size_t* chunk);
+};
+
+#endif  // WORKSTEALINGPOOL_H_
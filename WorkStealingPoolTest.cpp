@@ -0,0 +1,33 @@
+// Copyright 2022, Henry Herröder
+// Author: Henry Herröder
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+#include "./WorkStealingPool.h"
+
+TEST(WorkStealingPool, run) {
+    WorkStealingPool pool(4);
+    ASSERT_EQ(pool.threads(), 4u);
+    // every index exactly once, also for several jobs in a row
+    for (size_t n : {0, 1, 3, 1000, 12345}) {
+        vector<atomic<int>> calls(n);
+        atomic<bool> badWorker(false);
+        pool.run(n, [&](size_t i, unsigned int worker) {
+            ++calls[i];
+            if (worker >= 4)
+                badWorker = true;
+        });
+        for (size_t i = 0; i < n; ++i)
+            ASSERT_EQ(calls[i], 1) << i;
+        ASSERT_EQ(badWorker, false);
+    }
+}
+
+TEST(WorkStealingPool, singleThread) {
+    WorkStealingPool pool(1);
+    vector<int> calls(100, 0);
+    pool.run(calls.size(), [&](size_t i, unsigned int) { ++calls[i]; });
+    for (int c : calls)
+        ASSERT_EQ(c, 1);
+}